@@ -0,0 +1,103 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EFastMath.h: Polynomial sine and cosine, computed together, in a scalar and a 4-wide SSE2 version.
+// The angle is reduced to [-pi/4, pi/4] around the closest multiple of pi/2 (pi/2 split in three parts, Cody-Waite),
+// a degree 9 (sine) and degree 10 (cosine) polynomial is evaluated there and the quadrant swaps and negates the results.
+// Max absolute error against double precision: 8.5e-8 for |angle| <= 1000 (sinf/cosf: 3.3e-8), the reduction needs |angle| < 2^31 * pi/2.
+// The scalar and SSE2 versions can round angle * 2/pi differently close to halfway two integers, the results then differ by an ulp.
+/*=============================================================================*/
+#ifndef ELITE_MATH_FAST_MATH
+#define ELITE_MATH_FAST_MATH
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ELITE_FAST_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Elite {
+	/* --- CONSTANTS --- */
+	//pi/2 = FastMathPi2A + FastMathPi2B + FastMathPi2C, A and B have few enough bits that k * A and k * B are exact
+	constexpr float FastMathPi2A = 1.5703125f;
+	constexpr float FastMathPi2B = 4.837512969970703125e-4f;
+	constexpr float FastMathPi2C = 7.54978995489188216e-8f;
+	constexpr float FastMath2OverPi = 0.636619772367581343f;
+
+	/* --- FUNCTIONS --- */
+	/*! Sine and cosine of angle (radians) in one go, see the top of EFastMath.h for the error */
+	inline void SinCosFst(float angle, float& sine, float& cosine)
+	{
+		//Closest multiple of pi/2
+		const float kf = angle * FastMath2OverPi;
+		const int k = static_cast<int>(kf >= 0.f ? kf + 0.5f : kf - 0.5f);
+		const float r = ((angle - k * FastMathPi2A) - k * FastMathPi2B) - k * FastMathPi2C;
+		const float r2 = r * r;
+
+		const float s = r + r * r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f + r2 * (-1.98412698e-4f + r2 * 2.75573192e-6f)));
+		const float c = 1.f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f + r2 * (2.48015873e-5f + r2 * -2.75573192e-7f))));
+
+		//Quadrant: 0 (s, c), 1 (c, -s), 2 (-s, -c), 3 (-c, s), without branches
+		const bool isSwapped = (k & 1) != 0;
+		sine = static_cast<float>(1 - (k & 2)) * (isSwapped ? c : s);
+		cosine = static_cast<float>(1 - ((k + 1) & 2)) * (isSwapped ? s : c);
+	}
+
+#ifdef ELITE_FAST_MATH_SSE2
+	/*! SinCosFst on 4 angles at once */
+	inline void SinCosFst4(__m128 angles, __m128& sines, __m128& cosines)
+	{
+		//Rounds to nearest (the default rounding mode), ties can go either way, r stays within [-pi/4, pi/4] anyway
+		const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(angles, _mm_set1_ps(FastMath2OverPi)));
+		const __m128 kf = _mm_cvtepi32_ps(k);
+		__m128 r = _mm_sub_ps(angles, _mm_mul_ps(kf, _mm_set1_ps(FastMathPi2A)));
+		r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(FastMathPi2B)));
+		r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(FastMathPi2C)));
+		const __m128 r2 = _mm_mul_ps(r, r);
+
+		__m128 s = _mm_add_ps(_mm_set1_ps(-1.98412698e-4f), _mm_mul_ps(r2, _mm_set1_ps(2.75573192e-6f)));
+		s = _mm_add_ps(_mm_set1_ps(8.33333333e-3f), _mm_mul_ps(r2, s));
+		s = _mm_add_ps(_mm_set1_ps(-1.66666667e-1f), _mm_mul_ps(r2, s));
+		s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+
+		__m128 c = _mm_add_ps(_mm_set1_ps(2.48015873e-5f), _mm_mul_ps(r2, _mm_set1_ps(-2.75573192e-7f)));
+		c = _mm_add_ps(_mm_set1_ps(-1.38888889e-3f), _mm_mul_ps(r2, c));
+		c = _mm_add_ps(_mm_set1_ps(4.16666667e-2f), _mm_mul_ps(r2, c));
+		c = _mm_add_ps(_mm_set1_ps(-0.5f), _mm_mul_ps(r2, c));
+		c = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(r2, c));
+
+		//Same quadrant handling as SinCosFst, with masks: swap on bit 0, sign bits from bit 1 of k and k + 1
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+		const __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, _mm_set1_epi32(2)), 30));
+		const __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), _mm_set1_epi32(2)), 30));
+		sines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sineSign);
+		cosines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosineSign);
+	}
+#endif
+
+	/*! SinCosFst over arrays, 4 at a time when SSE2 is available */
+	inline void SinCosFst(const float* pAngles, float* pSines, float* pCosines, size_t count)
+	{
+		size_t i = 0;
+#ifdef ELITE_FAST_MATH_SSE2
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 sines, cosines;
+			SinCosFst4(_mm_loadu_ps(pAngles + i), sines, cosines);
+			_mm_storeu_ps(pSines + i, sines);
+			_mm_storeu_ps(pCosines + i, cosines);
+		}
+#endif
+		for (; i < count; ++i)
+			SinCosFst(pAngles[i], pSines[i], pCosines[i]);
+	}
+
+	/*! OrientationToVector with SinCosFst */
+	inline Vector2 OrientationToVectorFst(float orientation)
+	{
+		float sine, cosine;
+		SinCosFst(orientation - static_cast<float>(E_PI_2), sine, cosine);
+		return Vector2(cosine, sine);
+	}
+}
+#endif
@@ -15,6 +15,8 @@
 #include "EVector2.h"
 #include "EVector3.h"
 #include "EMat22.h"
+/* --- FAST APPROXIMATIONS --- */
+#include "EFastMath.h"
 
 /* --- TYPE DEFINES --- */
 #endif
@@ -10,36 +10,25 @@
 //-----------------------------------------------------------------
 #include "../inc/EliteMath/EMath.h"
 #include "EBehaviorTree.h"
-#include "SteeringBehaviors.h"
+#include "SteeringPipeline.h"
+#include "ExplorationPlanner.h"
+#include "Inventory.h"
+#include "InventoryOptimizer.h"
 
 
 //-----------------------------------------------------------------
 //helperfunctions forward decl.
 //-----------------------------------------------------------------
-bool ContainsItemOfType(const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange, const eItemType requiredType);
-bool ContainsItemOfType(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, const eItemType requiredType); //overloading for inventory
 bool IsCloseToCenter(const AgentInfo* pAgent, const std::vector<HouseInfo*>& pItemsInRange);
-bool IsEfficientToUse(unsigned char idx, IExamInterface* pInterface, AgentInfo* pAgent);
-bool IsLineSphereIntersection(const AgentInfo* pAgent, const EnemyInfo* pEnemy);
-EnemyInfo* GetEnemyByPriority(const AgentInfo*pAgent, const std::vector<EnemyInfo*>& pEnemies);
-
-unsigned char GetIdxOfInventoryItem(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType);
-unsigned char GetIdxOfInventoryItem(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType, IExamInterface* pInterface);
-
-unsigned char GetFirstFreeInventoryIdx(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory);
-std::vector<unsigned char> GetAllInventoryItemsOfType(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType);
-//std::vector<std::pair<unsigned char, ItemInfo*>> GetAllInventoryItemsOfType(const AgentInfo* pAgent, const std::unordered_map<);
-
-
-std::pair<EntityInfo, ItemInfo*> GetClosestItem(const AgentInfo* pAgent, const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange);
-std::pair<EntityInfo, ItemInfo*> GetClosestItemOfType(const AgentInfo* pAgent, const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange, const eItemType requiredType);
-std::unordered_map<int, std::pair<bool, Vector2>> GetAllAvailableWaypoints(const AgentInfo* pAgent, std::unordered_map<int, std::pair<bool, Vector2>> waypoints);
+bool IsEfficientToUse(const Inventory& inventory, unsigned int slot, const AgentInfo* pAgent);
+bool IsLineSphereIntersection(const AgentInfo* pAgent, const Vector2& direction, const EnemyInfo* pEnemy);
+const EnemyInfo* GetEnemyByPriority(const AgentInfo*pAgent, const PerceptionBuffers& perception);
 
 
 //-----------------------CONDITIONALS-------------------------
 bool ExploredWaypoint(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	Vector2 target{};
 	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Target", target) };
 	if (!dataAvailable || !pAgent)
@@ -49,41 +38,21 @@ bool ExploredWaypoint(Elite::Blackboard* pB)
 	return false;
 }
 
-bool IsCloseToPurgeZone(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	std::vector<PurgeZoneInfo*> pPurgeZone{};
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("PurgeZones",pPurgeZone) };
-	if (!dataAvailable || !pAgent || pPurgeZone.empty())
-		return false;
-	
-	auto it{ std::min_element(pPurgeZone.cbegin(), pPurgeZone.cend(),[&pAgent](const PurgeZoneInfo* pPZ1, const PurgeZoneInfo* pPZ2) {return DistanceSquared(pPZ1->Center, pAgent->Position) < DistanceSquared(pPZ2->Center, pAgent->Position);}) };
-	if (it == pPurgeZone.cend())
-		return false;
-
-	if (DistanceSquared((*it)->Center, pAgent->Position) >= ((*it)->Radius + 10)* ((*it)->Radius + 10))
-		return false;
-
-	pB->ChangeData("Target", (*it)->Center);
-	pB->ChangeData("WanderTimer", 5.f);
-	return true;
-}
-
-
 bool IsCloseToBorder(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
-	IExamInterface* pInterface{};
+	const AgentInfo* pAgent{ nullptr };
+	const FrameSnapshot* pFrame{ nullptr };
 	bool closeToBorder{ false };
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("pInterface",pInterface) && pB->GetData("CloseToBorder", closeToBorder)};
-	if (!dataAvailable || !pAgent)
+	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Frame",pFrame) && pB->GetData("CloseToBorder", closeToBorder)};
+	if (!dataAvailable || !pAgent || !pFrame)
 		return false;
 
 	if (closeToBorder)
 		return true;
 
-	Vector2 worldC{ pInterface->World_GetInfo().Center };
-	Vector2 worldS{ pInterface->World_GetInfo().Dimensions };
+	const WorldInfo& world{ pFrame->GetWorld() };
+	Vector2 worldC{ world.Center };
+	Vector2 worldS{ world.Dimensions };
 	bool isAtBorder{false};
 	if (pAgent->Position.x <= worldC.x - worldS.x / 2)
 	{
@@ -111,56 +80,21 @@ bool IsCloseToBorder(Elite::Blackboard* pB)
 	return isAtBorder;
 }
 //-------agent IS states-------
-bool IsHungry(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	auto dataAvailable{ pB->GetData("Agent", pAgent)};
-	if (!dataAvailable || !pAgent)
-		return false;
-	if (pAgent->Energy <= 7.1f)
-	{
-		//Add type for "Get/Has ItemOfAgentState functionality
-		pB->ChangeData("WantedType", eItemType::FOOD);
-		return true;
-	}
-	return false;
-}
-
 bool IsWanderActive(Elite::Blackboard* pB)
 {
-	float wanderTimer{};
+	bool isWandering{};
 
-	auto dataAvailable{  pB->GetData("WanderTimer", wanderTimer) };
+	auto dataAvailable{  pB->GetData("Wandering", isWandering) };
 	if (!dataAvailable)
 		return false;
-	if (wanderTimer <= 0 )
-	{
-		//Add type for "Get/Has ItemOfAgentState functionality
-		pB->ChangeData("WanderTimer", 0.f);
-		return false;
-	}
-	return true;
+	//Set when leaving a purge zone, the time limit on KeepWandering clears it
+	return isWandering;
 }
 
 
-bool IsInjured(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	auto dataAvailable{ pB->GetData("Agent", pAgent) };
-	if (!dataAvailable || !pAgent)
-		return false;
-
-	if (pAgent->Health <= 8.1f)
-	{
-		//Add type for "Get/Has ItemOfAgentState functionality
-		pB->ChangeData("WantedType", eItemType::MEDKIT);
-		return true;
-	}
-	return false;
-}
 bool IsBitten(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	bool turning{};
 	const bool dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Turning", turning) };
 	if (!dataAvailable || !pAgent)
@@ -180,36 +114,19 @@ bool IsBitten(Elite::Blackboard* pB)
 //-------ItemManagement-------
 bool HasGarbage(Elite::Blackboard* pB)
 {
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	Inventory* pInventory{};
 	auto dataAvailable{ pB->GetData("Inventory",pInventory) };
-	if (!dataAvailable || pInventory->empty())
-		return false;
-	if (ContainsItemOfType(*pInventory, eItemType::GARBAGE))
-	{
-		return true;
-	}
-	return false;
-}
-bool HasItemOfAgentState(Elite::Blackboard* pB)
-{
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
-	eItemType wantedType{};
-	auto dataAvailable{ pB->GetData("WantedType", wantedType) && pB->GetData("Inventory",pInventory) };
-	if (!dataAvailable || pInventory->empty())
+	if (!dataAvailable || !pInventory)
 		return false;
-	if (ContainsItemOfType(*pInventory, wantedType))
-	{
-		return true;
-	}
-	return false;
+	return pInventory->HasType(eItemType::GARBAGE);
 }
 bool HasGun(Elite::Blackboard* pB)
 {
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	Inventory* pInventory{};
 	auto dataAvailable{  pB->GetData("Inventory",pInventory) };
-	if (!dataAvailable || pInventory->empty())
+	if (!dataAvailable || !pInventory)
 		return false;
-	if (ContainsItemOfType(*pInventory, eItemType::PISTOL))
+	if (pInventory->HasType(eItemType::PISTOL))
 	{
 		//std::cout << "HAS GUN" << std::endl;
 		return true;
@@ -223,60 +140,11 @@ bool HasGun(Elite::Blackboard* pB)
 
 //-------ItemFinding-------
 
-bool HasFreeSlot(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItems{ };
-	IExamInterface* pInterface{ nullptr };
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
-
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Items", pItems) && pB->GetData("pInterface", pInterface) && pB->GetData("Inventory", pInventory)};
-	if (!dataAvailable || pItems.empty() || !pAgent || !pInterface)
-		return false;
-
-	auto it = std::find_if(pInventory->cbegin(), pInventory->cend(), [](const std::pair<unsigned char, ItemInfo*>& pItem) {return pItem.second == nullptr; });
-	if (it == pInventory->cend())
-		return false;
-	return true;
-}
-
-bool IsNearItems(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItems{ };
-	IExamInterface* pInterface{ nullptr };
-
-
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Items", pItems) && pB->GetData("pInterface", pInterface) };
-	if (!dataAvailable || pItems.empty() || !pAgent || !pInterface)
-		return false;
-
-
-	return true;
-}
-
-//To save codelines not having an IsFoodNearby, IsMedkitNearby, IsGunNearby... easier to expand
-bool IsItemOfTypeNearby(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItems{};
-	eItemType wantedType{};
-	IExamInterface* pInterface{ nullptr };
-
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Items", pItems) && pB->GetData("pInterface", pInterface) && pB->GetData("WantedType", wantedType)};
-	if (!dataAvailable || pItems.empty() || !pAgent || !pInterface)
-		return Failure;
-
-	//Returns true if food is in FOV
-	//std::cout << "ITEMS FOUND: " << pItems.size() << std::endl;
-
-	return ContainsItemOfType(pItems, wantedType);
-}
 //------------------------------
 //-------House management-------
 bool IsInHouse(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	std::vector<HouseInfo*> pHouses{ nullptr };
 	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Houses", pHouses) };
 	if (!dataAvailable || pHouses.empty() || !pAgent)
@@ -287,24 +155,9 @@ bool IsInHouse(Elite::Blackboard* pB)
 	}
 	return false;
 }
-bool IsForAWhile(Elite::Blackboard* pB)
-{
-	float* cooldown{new float()};
-	AgentInfo* pAgent{ nullptr };
-	std::vector<HouseInfo*> pHouses{ nullptr };
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Houses", pHouses) && pB->GetData("Cooldown", cooldown) };
-	if (!dataAvailable || pHouses.empty() || !pAgent)
-		return false;
-	if (*cooldown >= 5.f)
-	{
-		pB->ChangeData("Cooldown", 0);
-		return true;
-	}
-	return false;
-}
 bool IsNearHouse(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	std::vector<HouseInfo*> pHouses{ nullptr };
 	bool goingInside{};
 	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Houses", pHouses) &&pB->GetData("GoingInside",goingInside) };
@@ -318,7 +171,7 @@ bool IsNearHouse(Elite::Blackboard* pB)
 
 bool IsHouseExplored(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	std::vector<HouseInfo*> pHouses{ nullptr };
 	bool isLeavingHouse{};
 	auto dataAvailable{ pB->GetData("Houses", pHouses) && pB->GetData("Agent", pAgent) && pB->GetData("LeavingHouse",isLeavingHouse) };
@@ -333,7 +186,7 @@ bool IsHouseExplored(Elite::Blackboard* pB)
 
 bool LeftHouse(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	Vector2 outsidePos{};
 	bool isLeavingHouse{};
 	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("OutsidePos", outsidePos) && pB->GetData("LeavingHouse",isLeavingHouse) };
@@ -366,38 +219,21 @@ bool GoingInside(Blackboard* pB)
 }
 //--------------------------
 //-------Enemies-------
-bool IsInDanger(Elite::Blackboard* pB)
-{
-	AgentInfo* pAgent{ nullptr };
-	std::vector<EnemyInfo*> pEnemies{};
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Enemies", pEnemies) };
-	if (!dataAvailable || !pAgent || pEnemies.empty())
-		return false;
-
-	for (EnemyInfo* pEnemy : pEnemies)
-	{
-		if (DistanceSquared(pAgent->Position, pEnemy->Location) <= 256)
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
 bool IsAimingAtEnemy(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
-	std::vector<EnemyInfo*> pEnemies{};
-	const bool dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Enemies", pEnemies) };
-	if (!dataAvailable || !pAgent || pEnemies.empty())
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	const FrameSnapshot* pFrame{ nullptr };
+	const bool dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Perception", pPerception) && pB->GetData("Frame", pFrame) };
+	if (!dataAvailable || !pAgent || !pPerception || !pFrame || pPerception->Enemies.empty())
 		return false;
-	EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, pEnemies) };
+	const EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, *pPerception) };
 	//Endpoint of the shooting line trace
-	const Vector2 A{ pAgent->Position };
-	const Vector2 B{ pAgent->Position.x + pAgent->FOV_Range * cosf(pAgent->Orientation), pAgent->Position.y + pAgent->FOV_Range * sinf(pAgent->Orientation) };
+	const AgentBasis& basis{ pFrame->GetAgentBasis() };
+	const Vector2 B{ pAgent->Position + pAgent->FOV_Range * basis.Side };
 	if( DistanceSquared(B, pDangerousEnemy->Location) < 1)
 		return true;
-	return IsLineSphereIntersection(pAgent, pDangerousEnemy);
+	return IsLineSphereIntersection(pAgent, basis.Forward, pDangerousEnemy);
 }
 //-----------------------------------------------------------------
 
@@ -406,27 +242,27 @@ bool IsAimingAtEnemy(Elite::Blackboard* pB)
 //---------------------------ACTIONS-------------------------------
 BehaviorState ChangeToEvade(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) };
 	if (!dataAvailable || !pAgent )
 		return Failure;
 
-	pBlackboard->ChangeData("Behavior", std::string{ "Evade" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Evade);
 
 	return Success;
 }
 
 BehaviorState RunFromEnemy(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
-	std::vector<EnemyInfo*> pEnemies{};
-	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Enemies", pEnemies) };
-	if (!dataAvailable || !pAgent || pEnemies.empty())
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Perception", pPerception) };
+	if (!dataAvailable || !pAgent || !pPerception || pPerception->Enemies.empty())
 		return Failure;
 	
-	pBlackboard->ChangeData("Target", GetEnemyByPriority(pAgent, pEnemies)->Location);
+	pBlackboard->ChangeData("Target", GetEnemyByPriority(pAgent, *pPerception)->Location);
 
-	pBlackboard->ChangeData("Behavior", std::string{ "Evade" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Evade);
 
 	return Success;
 }
@@ -434,7 +270,7 @@ BehaviorState RunFromEnemy(Elite::Blackboard* pBlackboard)
 
 BehaviorState ChangeToWander(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent = nullptr;
+	const AgentInfo* pAgent = nullptr;
 	auto dataAvailable = pBlackboard->GetData("Agent", pAgent);
 
 	if (!dataAvailable || !pAgent)
@@ -442,28 +278,42 @@ BehaviorState ChangeToWander(Elite::Blackboard* pBlackboard)
 
 	Wander wander{};
 	
-	pBlackboard->ChangeData("Behavior", std::string{ "Wander" }) ;
+	pBlackboard->ChangeData("Behavior", SteeringType::Wander) ;
 	//std::cout << "wander" << std::endl;
 
 	return Success;
 }
 
+//Wanders until a BehaviorTimeLimit above it fails, StopWandering then clears the flag
+BehaviorState KeepWandering(Elite::Blackboard* pBlackboard)
+{
+	if (ChangeToWander(pBlackboard) == Failure)
+		return Failure;
+	return Running;
+}
+
+BehaviorState StopWandering(Elite::Blackboard* pBlackboard)
+{
+	pBlackboard->ChangeData("Wandering", false);
+	return Failure;
+}
+
 BehaviorState ChangeToSeek(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	Vector2 seekTarget{};
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)};
 
 	if (!dataAvailable || !pAgent)
 		return Failure;
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Seek);
 	//std::cout << "seeking to food" << std::endl;
 	return Success;
 }
 
 BehaviorState GoBack(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	Vector2 target{};
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Target", target) };
 
@@ -475,142 +325,129 @@ BehaviorState GoBack(Elite::Blackboard* pBlackboard)
 		return Failure;
 	}
 
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Seek);
 	//std::cout << "seeking to food" << std::endl;
 	return Success;
 }
 
 BehaviorState ChangeToFace(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	Vector2 seekTarget{};
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) };
 
 	if (!dataAvailable || !pAgent)
 		return Failure;
-	pBlackboard->ChangeData("Behavior", std::string{ "Face" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Face);
 	//std::cout << "seeking to food" << std::endl;
 	return Success;
 }
 
 BehaviorState FollowGrid(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
-	Vector2 target{};
-	std::unordered_map<int, std::pair<bool, Vector2>>* pWayPoints{nullptr};
+	const AgentInfo* pAgent{ nullptr };
+	ExplorationPlanner* pExploration{ nullptr };
 	
-	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Waypoints", pWayPoints)};
-	if (!dataAvailable || !pAgent || !pWayPoints)
+	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Exploration", pExploration)};
+	if (!dataAvailable || !pAgent || !pExploration)
 		return Failure;
 
-	std::unordered_map<int, std::pair<bool, Vector2>> pAvailableWaypoints{ GetAllAvailableWaypoints(pAgent, *pWayPoints) };
-
-	//need to edit bool of the mapelement
-	auto it = std::min_element(pAvailableWaypoints.begin(), pAvailableWaypoints.end(), [&pAgent](const std::pair<int, std::pair<bool, Vector2>>& waypointA, const std::pair<int, std::pair<bool, Vector2>>& waypointB)
-		{
-			return DistanceSquared(pAgent->Position, waypointA.second.second) < DistanceSquared(pAgent->Position, waypointB.second.second);
-		});
-	if (it == pAvailableWaypoints.cend())
+	//Next unvisited cell of the tour
+	const int cell{ pExploration->GetNextCell(pAgent->Position) };
+	if (cell == -1)
 		return Failure;
-	if (DistanceSquared(pAgent->Position, pWayPoints->at(it->first).second) < 15.f)
-		pWayPoints->at(it->first).first = true;
+	const Vector2 waypoint{ pExploration->GetCellCenter(cell) };
+	if (DistanceSquared(pAgent->Position, waypoint) < 15.f)
+		pExploration->MarkVisited(cell);
 
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
-	pBlackboard->ChangeData("Target", it->second.second);
+	//Context steering weighs the waypoint against enemies, purge zones and the border in one direction pick
+	pBlackboard->ChangeData("Behavior", SteeringType::Context);
+	pBlackboard->ChangeData("Target", waypoint);
 	//std::cout << "seeking to food" << std::endl;
 	return Success;
 
 }
 
-BehaviorState GetItem(Elite::Blackboard* pBlackboard)
+//Uses, drops and picks up whatever InventoryOptimizer plans for the items in FOV, heads to the closest pickup
+//Drops that make room for a pickup only happen once that item is grabbed
+BehaviorState OptimizeInventory(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItems{};
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	Inventory* pInventory{};
+	InventoryOptimizer* pOptimizer{};
 	IExamInterface* pInterface{ nullptr };
 
-
-	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) 
-		&& pBlackboard->GetData("Items", pItems) 
+	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)
+		&& pBlackboard->GetData("Perception", pPerception)
 		&& pBlackboard->GetData("pInterface", pInterface)
-		&& pBlackboard->GetData("Inventory", pInventory)};
-	if (!dataAvailable || pItems.empty() || !pAgent || !pInterface)
+		&& pBlackboard->GetData("Inventory", pInventory)
+		&& pBlackboard->GetData("InventoryOptimizer", pOptimizer) };
+	if (!dataAvailable || !pAgent || !pPerception || !pInterface || !pInventory || !pOptimizer)
 		return Failure;
 
-	std::pair<EntityInfo, ItemInfo*> closestItem = GetClosestItem(pAgent, pItems);
-	if (!closestItem.second)
+	const InventoryPlan& plan{ pOptimizer->Optimize(*pAgent, *pInventory, pPerception->Items, pInterface) };
+	if (plan.IsEmpty())
 		return Failure;
-	//Data Updating
-	//std::cout << "GETTING ITEM" << std::endl;
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
-	pBlackboard->ChangeData("Target", closestItem.second->Location);
 
-
-	size_t amountOfItem{ GetAllInventoryItemsOfType(*pInventory, closestItem.second->Type).size() };
-	if (closestItem.second->Type!=eItemType::PISTOL && amountOfItem >= 2)
-		return Failure;
-	//try to grab item
-	if ( pInterface->Item_Grab(closestItem.first, *closestItem.second))
+	bool isChanged{ false };
+	for (const unsigned int slot : plan.Uses)
 	{
-		pInterface->Inventory_AddItem(GetFirstFreeInventoryIdx(*pInventory), *closestItem.second);
-		pInventory->operator[](static_cast<unsigned char>(GetFirstFreeInventoryIdx(*pInventory))) = closestItem.second;
-
+		//Food and medkits are depleted in one use, a refused use keeps the item
+		if (!pInventory->Use(slot))
+			continue;
+		pInventory->Remove(slot);
+		isChanged = true;
+	}
+	if (plan.Pickups.empty())
+	{
+		for (const unsigned int slot : plan.Drops)
+			pInventory->Remove(slot);
+		if (isChanged || !plan.Drops.empty())
+			pBlackboard->MarkChanged("Inventory");
+		return Success;
 	}
-	return Success;
-
-}
-
-//To save codelines not having a GetFood, GetMedkit, GetGun... easy to expand and easier to read, no useless code recycling
-//If  Agent is hungry prioritize food
-BehaviorState GetItemOfType(Elite::Blackboard* pBlackboard)
-{
-	AgentInfo* pAgent{ nullptr };
-	eItemType wantedType{};
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItems{ };
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
-	IExamInterface* pInterface{ nullptr };
-
-
-	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) 
-		&& pBlackboard->GetData("Items", pItems)
-		&& pBlackboard->GetData("pInterface", pInterface)
-		&& pBlackboard->GetData("Inventory", pInventory) 
-		&& pBlackboard->GetData("WantedType", wantedType)};
-	if (!dataAvailable || pItems.empty() || !pAgent || !pInterface)
-		return Failure;
-
-	//Get the closest entity and item matching a specific eItemType (Prioritization hunger>hurt>gun) (see Ishungry, IsInjured...)
-	std::pair<EntityInfo, ItemInfo*> closestItemOfType{ GetClosestItemOfType(pAgent, pItems, wantedType) };
-	if (!closestItemOfType.second)
-		return Failure;
-	//Data Updating
-	//std::cout << "GETTING FOOD" << std::endl;
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
-	pBlackboard->ChangeData("Target", closestItemOfType.second->Location);
-	
-
 
-	size_t amountOfItem{ GetAllInventoryItemsOfType(*pInventory, wantedType).size() };
-	if (wantedType != eItemType::PISTOL && amountOfItem >= 2)
-		return Failure;
+	const size_t closestIdx{ plan.Pickups.front() };
+	//Copy, the perception buffers are overwritten next tick
+	ItemInfo closestItem{ pPerception->Items[closestIdx] };
+	pBlackboard->ChangeData("Behavior", SteeringType::Seek);
+	pBlackboard->ChangeData("Target", closestItem.Location);
 
-	//try to grab item
-	if (pInterface->Item_Grab(closestItemOfType.first, *closestItemOfType.second))
+	if (pInterface->Item_Grab(pPerception->ItemEntities[closestIdx], closestItem))
 	{
-		
-		pInterface->Inventory_AddItem(GetFirstFreeInventoryIdx(*pInventory), *closestItemOfType.second);
-		pInventory->operator[](static_cast<unsigned char>(GetFirstFreeInventoryIdx(*pInventory))) = closestItemOfType.second;
-
+		//Only free the one slot Add needs: the lowest value drop, of the grabbed type if there is one.
+		//The other drops stay until a later grab needs their slot.
+		if (!pInventory->HasFreeSlot() && !plan.Drops.empty())
+		{
+			unsigned int dropSlot{ Inventory::m_InvalidSlot };
+			bool isDropSameType{ false };
+			for (const unsigned int slot : plan.Drops)
+			{
+				const bool isSameType{ pInventory->GetItem(slot).Type == closestItem.Type };
+				if (dropSlot == Inventory::m_InvalidSlot || (isSameType && !isDropSameType)
+					|| (isSameType == isDropSameType && pInventory->GetValue(slot) < pInventory->GetValue(dropSlot)))
+				{
+					dropSlot = slot;
+					isDropSameType = isSameType;
+				}
+			}
+			pInventory->Remove(dropSlot);
+			isChanged = true;
+		}
+		if (pInventory->Add(closestItem) != Inventory::m_InvalidSlot)
+			isChanged = true;
 	}
+	if (isChanged)
+		pBlackboard->MarkChanged("Inventory");
 	return Success;
 }
 
-
 BehaviorState UseItemOfType(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	eItemType wantedType{};
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	Inventory* pInventory{};
 	IExamInterface* pInterface{ nullptr };
 
 
@@ -618,48 +455,57 @@ BehaviorState UseItemOfType(Elite::Blackboard* pBlackboard)
 		&& pBlackboard->GetData("pInterface", pInterface)
 		&& pBlackboard->GetData("Inventory", pInventory)
 		&& pBlackboard->GetData("WantedType", wantedType) };
-	if (!dataAvailable || !pAgent || !pInterface)
+	if (!dataAvailable || !pAgent || !pInterface || !pInventory)
 		return Failure;
 	//Get item of type from inventory and use! Drop if empty
-	std::vector<unsigned char> indices = GetAllInventoryItemsOfType(*pInventory, wantedType);
-
-	for (size_t i{ 0 }; i < indices.size(); i++)
+	for (unsigned int slots{ pInventory->GetSlotsOfType(wantedType) }; slots != 0; slots &= slots - 1)
 	{
+		const unsigned int slot{ Inventory::GetLowestBit(slots) };
 		//Only use the item if it's efficient to use (if item + current agent value <= max value
-		if (IsEfficientToUse(indices[i], pInterface, pAgent))
+		if (IsEfficientToUse(*pInventory, slot, pAgent))
 		{
-			pInterface->Inventory_UseItem(indices[i]);
-			pInterface->Inventory_RemoveItem(indices[i]); //drop other items when used (always fully depleted in game on 1 usage)
-			delete pInventory->at(indices[i]);
-			pInventory->at(indices[i]) = nullptr;
+			//drop other items when used (always fully depleted in game on 1 usage), a refused use keeps the item
+			if (!pInventory->Use(slot))
+				continue;
+			pInventory->Remove(slot);
+			pBlackboard->MarkChanged("Inventory");
 			return Success;
 		}
 	}
 	return Failure;
 }
 
+//Set the wanted type for UseItemOfType, the utility selector already decided the stat is low enough
+BehaviorState UseFood(Elite::Blackboard* pBlackboard)
+{
+	pBlackboard->ChangeData("WantedType", eItemType::FOOD);
+	return UseItemOfType(pBlackboard);
+}
+
+BehaviorState UseMedkit(Elite::Blackboard* pBlackboard)
+{
+	pBlackboard->ChangeData("WantedType", eItemType::MEDKIT);
+	return UseItemOfType(pBlackboard);
+}
+
 BehaviorState DestroyGarbage(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	const AgentInfo* pAgent{ nullptr };
+	Inventory* pInventory{};
 	IExamInterface* pInterface{ nullptr };
 
 
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)
 		&& pBlackboard->GetData("pInterface", pInterface)
 		&& pBlackboard->GetData("Inventory", pInventory) };
-	if (!dataAvailable || !pAgent || !pInterface)
+	if (!dataAvailable || !pAgent || !pInterface || !pInventory)
 		return Failure;
-	//Get item of type from inventory and use! Drop if empty
-	std::vector<unsigned char> indices = GetAllInventoryItemsOfType(*pInventory, eItemType::GARBAGE);
-	for (size_t i{ 0 }; i < indices.size(); i++)
-	{
-		
-		pInterface->Inventory_RemoveItem(indices[i]); //drop other items when used (always fully depleted in game on 1 usage)
-		delete pInventory->at(indices[i]);
-		pInventory->at(indices[i]) = nullptr;
-		
-	}
+	//Drop all garbage
+	const unsigned int garbageSlots{ pInventory->GetSlotsOfType(eItemType::GARBAGE) };
+	for (unsigned int slots{ garbageSlots }; slots != 0; slots &= slots - 1)
+		pInventory->Remove(Inventory::GetLowestBit(slots));
+	if (garbageSlots != 0)
+		pBlackboard->MarkChanged("Inventory");
 	return Success;
 
 }
@@ -668,21 +514,21 @@ BehaviorState DestroyGarbage(Elite::Blackboard* pBlackboard)
 
 BehaviorState AimAtEnemy(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
-	std::vector<EnemyInfo*> pEnemies{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
 
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)
-		&& pBlackboard->GetData("Enemies", pEnemies) };
-	if (!dataAvailable || pEnemies.empty())
+		&& pBlackboard->GetData("Perception", pPerception) };
+	if (!dataAvailable || !pPerception || pPerception->Enemies.empty())
 		return Failure;
 
 	//Aim at most dangerous enemy of the bunch
-	EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, pEnemies) };
+	const EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, *pPerception) };
 	if (pDangerousEnemy)
 	{
 		pBlackboard->ChangeData("Turning", false);
 
-		pBlackboard->ChangeData("Behavior", std::string("Face"));
+		pBlackboard->ChangeData("Behavior", SteeringType::Face);
 		pBlackboard->ChangeData("Target", pDangerousEnemy->Location);
 		return Success;
 	}
@@ -691,47 +537,55 @@ BehaviorState AimAtEnemy(Elite::Blackboard* pBlackboard)
 
 BehaviorState Turn(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
+	const FrameSnapshot* pFrame{ nullptr };
 	bool isTurning{};
-	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)  && pBlackboard->GetData("Turning", isTurning)};
-	if (!dataAvailable)
+	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent) && pBlackboard->GetData("Frame", pFrame) && pBlackboard->GetData("Turning", isTurning)};
+	if (!dataAvailable || !pAgent || !pFrame)
 		return Failure;
 	
-	Vector2 target{ pAgent->Position.x + 2 * cosf(pAgent->Orientation - 3 * static_cast<float>(M_PI)), pAgent->Position.y + 2 * sinf(pAgent->Orientation - 3 * static_cast<float>(M_PI)) };
-	pBlackboard->ChangeData("Behavior", std::string("FaceSeek"));
+	//Orientation - 3 PI points opposite of the side axis
+	Vector2 target{ pAgent->Position - 2.f * pFrame->GetAgentBasis().Side };
+	pBlackboard->ChangeData("Behavior", SteeringType::FaceSeek);
 	pBlackboard->ChangeData("Target", target);
-	return Success;
+	//Keeps turning until a BehaviorTimeLimit above it fails, StopTurning then clears the flag
+	return Running;
 	
 }
 
+BehaviorState StopTurning(Elite::Blackboard* pBlackboard)
+{
+	pBlackboard->ChangeData("Turning", false);
+	return Failure;
+}
+
 BehaviorState Shoot(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{nullptr};
-	std::unordered_map<unsigned char, ItemInfo*>* pInventory{};
+	const AgentInfo* pAgent{nullptr};
+	Inventory* pInventory{};
 	IExamInterface* pInterface{ nullptr };
-	std::vector<EnemyInfo*> pEnemies{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
 	
 	auto dataAvailable{ pBlackboard->GetData("Agent", pAgent)
 		&& pBlackboard->GetData("pInterface", pInterface)
 		&& pBlackboard->GetData("Inventory", pInventory)
-		&& pBlackboard->GetData("Enemies", pEnemies)};
-	if (!dataAvailable || !pInterface || pEnemies.empty())
+		&& pBlackboard->GetData("Perception", pPerception)};
+	if (!dataAvailable || !pInterface || !pInventory || !pPerception || pPerception->Enemies.empty())
 		return Failure; 
 	
-	const unsigned char idx{ GetIdxOfInventoryItem(*pInventory, eItemType::PISTOL, pInterface) };
-	if (!pInventory->at(idx))
+	const unsigned int slot{ pInventory->GetBestPistolSlot() };
+	if (slot == Inventory::m_InvalidSlot)
 		return Failure;
 	//Is enemy still there
-	EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, pEnemies) };
+	const EnemyInfo* pDangerousEnemy{ GetEnemyByPriority(pAgent, *pPerception) };
 	if(pDangerousEnemy)
-		pInterface->Inventory_UseItem(idx);
+		pInventory->Use(slot);
 
-	//drop if weapon empty
-	if (pInterface->Weapon_GetAmmo(*pInventory->at(idx)) <= 0)
+	//drop if weapon empty, the ammo was refreshed by Use
+	if (pInventory->GetValue(slot) <= 0)
 	{
-		pInterface->Inventory_RemoveItem(idx);
-		delete pInventory->at(idx);
-		pInventory->at(idx) = nullptr;
+		pInventory->Remove(slot);
+		pBlackboard->MarkChanged("Inventory");
 	}
 	pBlackboard->ChangeData("GoingInside", false);
 
@@ -740,7 +594,7 @@ BehaviorState Shoot(Elite::Blackboard* pBlackboard)
 
 BehaviorState EnterHouse(Elite::Blackboard* pBlackboard)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	std::vector<HouseInfo*> pHouses{ nullptr };
 	bool isEnteringHouse{};
 
@@ -757,7 +611,7 @@ BehaviorState EnterHouse(Elite::Blackboard* pBlackboard)
 	else if(toHouse.y>0)
 		target.y += pHouses[0]->Size.y / 2 + 4;
 
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Seek);
 	pBlackboard->ChangeData("Target", pHouses[0]->Center);
 
 	if (!isEnteringHouse)
@@ -769,7 +623,7 @@ BehaviorState EnterHouse(Elite::Blackboard* pBlackboard)
 BehaviorState LeaveHouse(Elite::Blackboard* pBlackboard)
 {
 	Vector2 outsidePos{};
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	std::vector<HouseInfo*> pHouses{ nullptr };
 	std::vector<HouseInfo*> pExploredHouses{ nullptr };
 	bool leavingHouse{};
@@ -786,21 +640,21 @@ BehaviorState LeaveHouse(Elite::Blackboard* pBlackboard)
 		pBlackboard->ChangeData("ExploredHouses", pExploredHouses);
 
 	pBlackboard->ChangeData("LeavingHouse", true);
-	pBlackboard->ChangeData("Behavior", std::string{ "Seek" });
+	pBlackboard->ChangeData("Behavior", SteeringType::Seek);
 	pBlackboard->ChangeData("Target", outsidePos);
 	return Success;
 }
 
 BehaviorState EscapeHouse(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
+	const AgentInfo* pAgent{ nullptr };
 	auto dataAvailable{ pB->GetData("Agent", pAgent)};
 	if (!dataAvailable || !pAgent)
 		return Failure;
 
 	Vector2 dir{ pAgent->Position.x - 10, pAgent->Position.y };
 
-	pB->ChangeData("Behavior", std::string{ "Seek" });
+	pB->ChangeData("Behavior", SteeringType::Seek);
 
 	pB->ChangeData("Target", dir);
 	return Success;
@@ -808,67 +662,122 @@ BehaviorState EscapeHouse(Elite::Blackboard* pB)
 
 BehaviorState EscapePurgeZone(Elite::Blackboard* pB)
 {
-	AgentInfo* pAgent{ nullptr };
-	Vector2 target{};
-	std::vector<PurgeZoneInfo*> pPurgeZone{};
-	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Target",target) && pB->GetData("PurgeZones",pPurgeZone) };
-	if (!dataAvailable || !pAgent)
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Perception",pPerception) };
+	if (!dataAvailable || !pAgent || !pPerception || pPerception->PurgeZones.empty())
 		return Failure;
 
-	Vector2 dirToAgent{ pAgent->Position - target };
+	const auto& purgeZones{ pPerception->PurgeZones };
+	auto it{ std::min_element(purgeZones.cbegin(), purgeZones.cend(),[&pAgent](const PurgeZoneInfo& pz1, const PurgeZoneInfo& pz2) {return DistanceSquared(pz1.Center, pAgent->Position) < DistanceSquared(pz2.Center, pAgent->Position);}) };
+
+	//Straight out of the closest zone, a bit past its edge
+	Vector2 dirToAgent{ pAgent->Position - it->Center };
 	dirToAgent = dirToAgent.GetNormalized();
-	dirToAgent *= pPurgeZone[0]->Radius + 3;
-	dirToAgent = pPurgeZone[0]->Center + dirToAgent;
-	pB->ChangeData("Target", dirToAgent);
-	pB->ChangeData("Behavior", std::string{ "Seek" });
+	dirToAgent *= it->Radius + 13;
+	pB->ChangeData("Target", it->Center + dirToAgent);
+	pB->ChangeData("Behavior", SteeringType::Seek);
+	pB->ChangeData("Wandering", true);
 	return Success;
-
 }
 
 //-----------------------------------------------------------------------
 
+//-----------------------UTILITY INPUTS-------------------------
+//Inputs for BehaviorUtilitySelector, read once per tick
+float GetEnergyInput(Elite::Blackboard* pB)
+{
+	const AgentInfo* pAgent{ nullptr };
+	if (!pB->GetData("Agent", pAgent) || !pAgent)
+		return 0.f;
+	return pAgent->Energy;
+}
+float GetHealthInput(Elite::Blackboard* pB)
+{
+	const AgentInfo* pAgent{ nullptr };
+	if (!pB->GetData("Agent", pAgent) || !pAgent)
+		return 0.f;
+	return pAgent->Health;
+}
+//FLT_MAX without enemies in FOV
+float GetClosestEnemyDistanceInput(Elite::Blackboard* pB)
+{
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Perception", pPerception) };
+	if (!dataAvailable || !pAgent || !pPerception || pPerception->Enemies.empty())
+		return FLT_MAX;
 
+	const float* pX{ pPerception->EnemyPositionsX.data() };
+	const float* pY{ pPerception->EnemyPositionsY.data() };
+	float closestDistanceSquared{ FLT_MAX };
+	for (size_t i{}; i < pPerception->Enemies.size(); ++i)
+	{
+		const float dx{ pX[i] - pAgent->Position.x };
+		const float dy{ pY[i] - pAgent->Position.y };
+		closestDistanceSquared = (std::min)(closestDistanceSquared, dx * dx + dy * dy);
+	}
+	return sqrtf(closestDistanceSquared);
+}
+//Distance to the edge of the closest purge zone in FOV, negative inside, FLT_MAX without purge zones
+float GetPurgeZoneDistanceInput(Elite::Blackboard* pB)
+{
+	const AgentInfo* pAgent{ nullptr };
+	const PerceptionBuffers* pPerception{ nullptr };
+	auto dataAvailable{ pB->GetData("Agent", pAgent) && pB->GetData("Perception", pPerception) };
+	if (!dataAvailable || !pAgent || !pPerception)
+		return FLT_MAX;
 
+	float closestDistance{ FLT_MAX };
+	for (const PurgeZoneInfo& zone : pPerception->PurgeZones)
+		closestDistance = (std::min)(closestDistance, Distance(zone.Center, pAgent->Position) - zone.Radius);
+	return closestDistance;
+}
+float GetItemsInFOVInput(Elite::Blackboard* pB)
+{
+	const PerceptionBuffers* pPerception{ nullptr };
+	if (!pB->GetData("Perception", pPerception) || !pPerception)
+		return 0.f;
+	return static_cast<float>(pPerception->Items.size());
+}
+//Inventory inputs are cached per slot, no interface calls
+float GetAmmoInput(Elite::Blackboard* pB)
+{
+	Inventory* pInventory{};
+	if (!pB->GetData("Inventory", pInventory) || !pInventory)
+		return 0.f;
+	return static_cast<float>(pInventory->GetTotalValue(eItemType::PISTOL));
+}
+float GetFoodCountInput(Elite::Blackboard* pB)
+{
+	Inventory* pInventory{};
+	if (!pB->GetData("Inventory", pInventory) || !pInventory)
+		return 0.f;
+	return static_cast<float>(pInventory->GetCountOfType(eItemType::FOOD));
+}
+float GetMedkitCountInput(Elite::Blackboard* pB)
+{
+	Inventory* pInventory{};
+	if (!pB->GetData("Inventory", pInventory) || !pInventory)
+		return 0.f;
+	return static_cast<float>(pInventory->GetCountOfType(eItemType::MEDKIT));
+}
+//--------------------------------------------------------------
 
 
 
 
 //-------------------------HELPER FUNCTIONS------------------------------
-bool ContainsItemOfType(const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange, const eItemType requiredType)
-{
-	//objects in range collection
-	//Get closest item
-	auto it = std::find_if(pItemsInRange.cbegin(), pItemsInRange.cend(), [requiredType](const std::pair<EntityInfo, ItemInfo*> pItem) {return pItem.second->Type == requiredType; });
-	if (it != pItemsInRange.cend())
-		return true;
-	return false;
-
-}
-
-bool ContainsItemOfType(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, const eItemType wantedType)
-{
-	auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pItem) 
-		{
-			if(pItem.second)
-				return pItem.second->Type == wantedType; 
-			return false;
-		});
-	if (it != pItemsInInventory.cend())
-		return true;
-	return false;
-}
-bool IsEfficientToUse(unsigned char idx, IExamInterface* pInterface, AgentInfo* pAgent)
+bool IsEfficientToUse(const Inventory& inventory, unsigned int slot, const AgentInfo* pAgent)
 {
-	ItemInfo pItemInfo{ };
-	pInterface->Inventory_GetItem(idx, pItemInfo);
-	switch (pItemInfo.Type)
+	switch (inventory.GetItem(slot).Type)
 	{
 	case eItemType::FOOD:
-		if (pInterface->Food_GetEnergy(pItemInfo) + pAgent->Energy <= 10)
+		if (inventory.GetValue(slot) + pAgent->Energy <= 10)
 			return true;
 			break;
 	case eItemType::MEDKIT:
-		if (pInterface->Medkit_GetHealth(pItemInfo) + pAgent->Health <= 10)
+		if (inventory.GetValue(slot) + pAgent->Health <= 10)
 			return true;
 		break;
 	case eItemType::PISTOL:
@@ -891,10 +800,10 @@ bool IsCloseToCenter(const AgentInfo* pAgent, const std::vector<HouseInfo*>& pHo
 	return false;
 }
 
-bool IsLineSphereIntersection(const AgentInfo* pAgent, const EnemyInfo* pEnemy)
+bool IsLineSphereIntersection(const AgentInfo* pAgent, const Vector2& direction, const EnemyInfo* pEnemy)
 {
 	const Vector2 rayO{ pAgent->Position };
-	const Vector2 rayD{ cosf(pAgent->Orientation -  static_cast<float>(M_PI) / 2), sinf(pAgent->Orientation - static_cast<float>(M_PI) / 2)};
+	const Vector2& rayD{ direction };
 	const Vector2 center{pEnemy->Location};
 	float radius{ pEnemy->Size };
 	float radius2{ radius * radius };
@@ -912,209 +821,41 @@ bool IsLineSphereIntersection(const AgentInfo* pAgent, const EnemyInfo* pEnemy)
 
 
 
-EnemyInfo* GetEnemyByPriority(const AgentInfo* pAgent, const std::vector<EnemyInfo*>& pEnemies)
+const EnemyInfo* GetEnemyByPriority(const AgentInfo* pAgent, const PerceptionBuffers& perception)
 {
 	//Runners are more dangerous than other kinds, prioritize
-	std::vector<EnemyInfo*> pEnemiesByPriority{};
-	auto it{ std::find_if(pEnemies.cbegin(), pEnemies.cend(), [](const EnemyInfo* pEnemy) {return pEnemy->Type == eEnemyType::ZOMBIE_RUNNER; }) };
-
-	if (it != pEnemies.cend())
-		pEnemiesByPriority.push_back(*it);
-
-	//Add all Runners items to foodvec
-	while (it != pEnemies.cend())
+	//Closest runner and closest enemy are tracked in the same pass over the positions
+	const float* pX{ perception.EnemyPositionsX.data() };
+	const float* pY{ perception.EnemyPositionsY.data() };
+	const size_t count{ perception.Enemies.size() };
+	size_t closestIdx{ count };
+	size_t closestRunnerIdx{ count };
+	float closestDistanceSquared{ FLT_MAX };
+	float closestRunnerDistanceSquared{ FLT_MAX };
+	for (size_t i{}; i < count; ++i)
 	{
-		it = std::find_if(std::next(it), pEnemies.cend(), [](const EnemyInfo* pEnemy){ return pEnemy->Type == eEnemyType::ZOMBIE_RUNNER;});
-		if (it != pEnemies.cend())
-			pEnemiesByPriority.push_back(*it);
-	}
-	if (!pEnemiesByPriority.empty())
-	{
-		return *std::min_element(pEnemiesByPriority.cbegin(), pEnemiesByPriority.cend(), [&pAgent](const EnemyInfo* pRunner, const EnemyInfo* pOtherRunner) { return DistanceSquared(pRunner->Location, pAgent->Position) < DistanceSquared(pOtherRunner->Location, pAgent->Position); });
-	}
-	//Normal/heavy enemies < Runners in prio
-	return *std::min_element(pEnemies.cbegin(), pEnemies.cend(), [&pAgent](const EnemyInfo* pEnemy, const EnemyInfo* pOtherEnemy) { return DistanceSquared(pEnemy->Location, pAgent->Position) < DistanceSquared(pOtherEnemy->Location, pAgent->Position); });
-}
-
-unsigned char GetIdxOfInventoryItem(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType, IExamInterface* pInterface)
-{
-	if (wantedType == eItemType::PISTOL)
-	{
-
-		std::vector<std::pair<unsigned char, ItemInfo*>> pGunsInInventory{};
-
-		//Find food in item vec, add to temp vec if exist
-		auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pGun)
-			{
-				if (pGun.second)
-					return pGun.second->Type == wantedType;
-				return false;
-			});
-		if (it != pItemsInInventory.cend())
-			pGunsInInventory.push_back(*it);
-
-		//Add all food items to foodvec
-		while (it != pItemsInInventory.cend())
+		const float dx{ pX[i] - pAgent->Position.x };
+		const float dy{ pY[i] - pAgent->Position.y };
+		const float distanceSquared{ dx * dx + dy * dy };
+		if (distanceSquared < closestDistanceSquared)
 		{
-			it = std::find_if(std::next(it), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pGun)
-				{
-					if (pGun.second)
-						return pGun.second->Type == wantedType;
-					return false;
-				});
-			if (it != pItemsInInventory.cend())
-				pGunsInInventory.push_back(*it);
+			closestDistanceSquared = distanceSquared;
+			closestIdx = i;
 		}
-
-		//Go over tempFoodVec, get closest foodItem
-		if (!pGunsInInventory.empty())
+		if (perception.Enemies[i].Type == eEnemyType::ZOMBIE_RUNNER && distanceSquared < closestRunnerDistanceSquared)
 		{
-
-			auto it = std::min_element(pGunsInInventory.begin(), pGunsInInventory.end(), [&pInterface](const std::pair<unsigned char, ItemInfo*>& pGunA, const std::pair<unsigned char, ItemInfo*>& pGunB)
-				{
-					return pInterface->Weapon_GetAmmo(*pGunA.second) < pInterface->Weapon_GetAmmo(*pGunB.second); 
-				});
-			if (it != pGunsInInventory.cend())
-				return  it->first;
+			closestRunnerDistanceSquared = distanceSquared;
+			closestRunnerIdx = i;
 		}
-		return 0;
 	}
-
-	auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pItem)
-		{
-			if(pItem.second) 
-				return pItem.second->Type == wantedType; 
-			return false;
-		});
-	if (it != pItemsInInventory.cend())
-		return it->first;
-	return 0;
-}
-
-
-unsigned char GetIdxOfInventoryItem(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType)
-{
-
-	auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pItem)
-		{
-			if (pItem.second)
-				return pItem.second->Type == wantedType;
-			return false;
-		});
-	if (it != pItemsInInventory.cend())
-		return it->first;
-	return 0;
-}
-
-
-unsigned char GetFirstFreeInventoryIdx(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory)
-{
-	auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [](const std::pair<unsigned char, ItemInfo*>& pItem) {return pItem.second == nullptr; });
-	if (it != pItemsInInventory.cend())
-		return it->first;
-	return 0;
+	if (closestRunnerIdx < count)
+		return &perception.Enemies[closestRunnerIdx];
+	//Normal/heavy enemies < Runners in prio
+	if (closestIdx < count)
+		return &perception.Enemies[closestIdx];
+	return nullptr;
 }
 
-
-
-std::vector<unsigned char> GetAllInventoryItemsOfType(const std::unordered_map<unsigned char, ItemInfo*>& pItemsInInventory, eItemType wantedType)
-{
-	std::vector<unsigned char> pTempItemOfTypeVec{};
-
-	//Find food in item vec, add to temp vec if exist
-	auto it = std::find_if(pItemsInInventory.cbegin(), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pItem) 
-		{
-			if (pItem.second)
-				return pItem.second->Type == wantedType;
-			return false;
-		});
-	if (it != pItemsInInventory.cend())
-		pTempItemOfTypeVec.push_back(it->first);
-
-	//Add all food items to foodvec
-	while (it != pItemsInInventory.cend())
-	{
-		it = std::find_if(std::next(it), pItemsInInventory.cend(), [wantedType](const std::pair<unsigned char, ItemInfo*>& pItem) 
-			{
-				if (pItem.second)
-					return pItem.second->Type == wantedType;
-				return false;
-			});
-		if (it != pItemsInInventory.cend())
-			pTempItemOfTypeVec.push_back(it->first);
-	}
-
-	//Go over tempFoodVec, get closest foodItem
-	if (!pTempItemOfTypeVec.empty())
-		return pTempItemOfTypeVec;
-	return std::vector<unsigned char>{};
-}
 //----------------------------------------------------------------------
 
-
-std::pair<EntityInfo, ItemInfo*> GetClosestItem(const AgentInfo* pAgent, const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange)
-{
-	//objects in range collection
-	//Get closest item
-	if (!pItemsInRange.empty())
-		return *std::min_element(pItemsInRange.cbegin(), pItemsInRange.cend(), [&pAgent](const std::pair<EntityInfo, ItemInfo*> oA, const std::pair<EntityInfo, ItemInfo*> oB) {return DistanceSquared(pAgent->Position, oA.second->Location) < DistanceSquared(pAgent->Position, oB.second->Location); });
-
-	return std::pair<EntityInfo, ItemInfo*>{};
-}
-
-std::pair<EntityInfo, ItemInfo*> GetClosestItemOfType(const AgentInfo* pAgent, const std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInRange, const eItemType requiredType)
-{
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pTempItemOfTypeVec{};
-
-	//Find food in item vec, add to temp vec if exist
-	auto it = std::find_if(pItemsInRange.cbegin(), pItemsInRange.cend(), [requiredType](const std::pair<EntityInfo, ItemInfo*> pItem) {return pItem.second->Type == requiredType; });
-	if (it != pItemsInRange.cend())
-		pTempItemOfTypeVec.push_back(*it);
-
-	//Add all food items to foodvec
-	while (it != pItemsInRange.cend())
-	{
-		it = std::find_if(std::next(it), pItemsInRange.cend(), [requiredType](const std::pair<EntityInfo, ItemInfo*> pItem) {return pItem.second->Type == requiredType; });
-		if (it != pItemsInRange.cend())
-			pTempItemOfTypeVec.push_back(*it);
-	}
-	//Go over tempFoodVec, get closest foodItem
-	if (!pTempItemOfTypeVec.empty())
-		return *std::min_element(pTempItemOfTypeVec.cbegin(), pTempItemOfTypeVec.cend(), [&pAgent](const std::pair<EntityInfo, ItemInfo*> oA, const std::pair<EntityInfo, ItemInfo*> oB) {return DistanceSquared(pAgent->Position, oA.second->Location) < DistanceSquared(pAgent->Position, oB.second->Location); });
-
-	return std::pair<EntityInfo, ItemInfo*>{};
-}
-
-//--------------------------------------------------------------
-std::unordered_map<int, std::pair<bool, Vector2>> GetAllAvailableWaypoints(const AgentInfo* pAgent, std::unordered_map<int, std::pair<bool, Vector2>> waypoints)
-{
-	std::unordered_map<int, std::pair<bool, Vector2>> availableWayPoints{};
-
-	//Find food in item vec, add to temp vec if exist
-	auto it = std::find_if(waypoints.cbegin(), waypoints.cend(), [](const std::pair<int, std::pair<bool, Vector2>> waypoint)
-		{
-			return !waypoint.second.first;
-		});
-	if (it != waypoints.cend())
-		availableWayPoints[it->first] = it->second;
-
-	//Add all food items to foodvec
-	while (it != waypoints.cend())
-	{
-		it = std::find_if(std::next(it), waypoints.cend(), [](const std::pair<int, std::pair<bool, Vector2>> waypoint)
-			{
-				return !waypoint.second.first;
-			});
-
-		if (it != waypoints.cend())
-			availableWayPoints[it->first] = it->second;
-
-	}
-
-	//Go over tempFoodVec, get closest foodItem
-	if (!availableWayPoints.empty())
-		return availableWayPoints;
-	return std::unordered_map<int, std::pair<bool, Vector2>>{};
-}
-
 #endif
@@ -9,9 +9,11 @@ using namespace Elite;
 //SELECTOR
 BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 {
-	for (auto child : m_ChildrenBehaviors)
+	const unsigned int startIndex = m_RunningBehaviorIndex;
+	m_RunningBehaviorIndex = 0;
+	for (unsigned int i = startIndex; i < m_ChildrenBehaviors.size(); ++i)
 	{
-		m_CurrentState = child->Execute(pBlackBoard);
+		m_CurrentState = m_ChildrenBehaviors[i]->Execute(pBlackBoard);
 		switch (m_CurrentState)
 		{
 		case Failure:
@@ -19,6 +21,8 @@ BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 		case Success:
 			return m_CurrentState; break;
 		case Running:
+			if (m_IsResumingRunning)
+				m_RunningBehaviorIndex = i;
 			return m_CurrentState; break;
 		default:
 			continue; break;
@@ -29,9 +33,11 @@ BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 //SEQUENCE
 BehaviorState BehaviorSequence::Execute(Blackboard* pBlackBoard)
 {
-	for (auto child : m_ChildrenBehaviors)
+	const unsigned int startIndex = m_RunningBehaviorIndex;
+	m_RunningBehaviorIndex = 0;
+	for (unsigned int i = startIndex; i < m_ChildrenBehaviors.size(); ++i)
 	{
-		m_CurrentState = child->Execute(pBlackBoard);
+		m_CurrentState = m_ChildrenBehaviors[i]->Execute(pBlackBoard);
 		switch (m_CurrentState)
 		{
 		case Failure:
@@ -39,6 +45,8 @@ BehaviorState BehaviorSequence::Execute(Blackboard* pBlackBoard)
 		case Success:
 			continue; break;
 		case Running:
+			if (m_IsResumingRunning)
+				m_RunningBehaviorIndex = i;
 			return m_CurrentState; break;
 		default:
 			m_CurrentState = Success;
@@ -69,6 +77,188 @@ BehaviorState BehaviorPartialSequence::Execute(Blackboard* pBlackBoard)
 	m_CurrentBehaviorIndex = 0;
 	return m_CurrentState = Success;
 }
+//UTILITY SELECTOR
+BehaviorUtilitySelector::BehaviorUtilitySelector(std::vector<std::function<float(Blackboard*)>> inputs, std::vector<UtilityOption> options)
+	: BehaviorComposite({}), m_fpInputs(inputs)
+{
+	m_Inputs.resize(m_fpInputs.size(), 0.f);
+	for (const auto& option : options)
+	{
+		m_ChildrenBehaviors.push_back(option.pBehavior);
+		m_Weights.push_back(option.Weight);
+		for (const auto& consideration : option.Considerations)
+		{
+			assert(consideration.Input < m_fpInputs.size() && "<BehaviorUtilitySelector>: consideration uses an unknown input");
+			const float range = consideration.Max - consideration.Min;
+			m_InputIndices.push_back(consideration.Input);
+			m_Mins.push_back(consideration.Min);
+			m_InvRanges.push_back(abs(range) > FLT_EPSILON ? 1.f / range : 0.f);
+			m_Slopes.push_back(consideration.Slope);
+			m_Offsets.push_back(consideration.Offset);
+			m_Exponents.push_back(consideration.IsQuadratic ? 1.f : 0.f);
+		}
+		m_ConsiderationEnds.push_back(static_cast<unsigned int>(m_InputIndices.size()));
+	}
+	m_Scores.resize(m_ChildrenBehaviors.size(), 0.f);
+	m_Order.resize(m_ChildrenBehaviors.size());
+	for (size_t i = 0; i < m_Order.size(); ++i)
+		m_Order[i] = i;
+	m_Responses.resize(m_InputIndices.size(), 0.f);
+}
+BehaviorState BehaviorUtilitySelector::Execute(Blackboard* pBlackBoard)
+{
+	for (size_t i = 0; i < m_fpInputs.size(); ++i)
+		m_Inputs[i] = m_fpInputs[i](pBlackBoard);
+
+	//One branchless pass over all considerations
+	const size_t considerationCount = m_Responses.size();
+	for (size_t i = 0; i < considerationCount; ++i)
+	{
+		const float x = Clamp((m_Inputs[m_InputIndices[i]] - m_Mins[i]) * m_InvRanges[i], 0.f, 1.f);
+		const float curve = x * (1.f + m_Exponents[i] * (x - 1.f)); //x or x*x
+		m_Responses[i] = Clamp(m_Slopes[i] * curve + m_Offsets[i], 0.f, 1.f);
+	}
+
+	unsigned int considerationBegin = 0;
+	for (size_t i = 0; i < m_ChildrenBehaviors.size(); ++i)
+	{
+		float score = m_Weights[i];
+		for (unsigned int c = considerationBegin; c < m_ConsiderationEnds[i]; ++c)
+			score *= m_Responses[c];
+		considerationBegin = m_ConsiderationEnds[i];
+		m_Scores[i] = score;
+	}
+
+	//Highest score first (ties in child order), a child that fails hands over to the next one like in a selector
+	std::sort(m_Order.begin(), m_Order.end(), [this](size_t a, size_t b)
+		{ return m_Scores[a] > m_Scores[b] || (m_Scores[a] == m_Scores[b] && a < b); });
+	for (size_t i : m_Order)
+	{
+		if (m_Scores[i] <= 0.f)
+			break;
+		m_CurrentState = m_ChildrenBehaviors[i]->Execute(pBlackBoard);
+		if (m_CurrentState != Failure)
+			return m_CurrentState;
+	}
+	return m_CurrentState = Failure;
+}
+#pragma endregion
+//-----------------------------------------------------------------
+// BEHAVIOR TREE DECORATORS (IBehavior)
+//-----------------------------------------------------------------
+#pragma region DECORATORS
+//DECORATOR BASE
+BehaviorState BehaviorDecorator::Execute(Blackboard* pBlackBoard)
+{
+	if (m_pChildBehavior == nullptr)
+		return m_CurrentState = Failure;
+
+	BehaviorState state = Failure;
+	if (!CanExecuteChild(pBlackBoard, state))
+		return m_CurrentState = state;
+
+	return m_CurrentState = HandleChildState(pBlackBoard, m_pChildBehavior->Execute(pBlackBoard));
+}
+//INVERTER
+BehaviorState BehaviorInverter::HandleChildState(Blackboard*, BehaviorState childState)
+{
+	switch (childState)
+	{
+	case Failure:
+		return Success;
+	case Success:
+		return Failure;
+	default:
+		return childState;
+	}
+}
+//REPEAT
+BehaviorState BehaviorRepeat::HandleChildState(Blackboard*, BehaviorState childState)
+{
+	switch (childState)
+	{
+	case Failure:
+		m_SuccessCount = 0;
+		return Failure;
+	case Success:
+		if (m_RepeatCount == 0 || ++m_SuccessCount < m_RepeatCount)
+			return Running;
+		m_SuccessCount = 0;
+		return Success;
+	default:
+		return childState;
+	}
+}
+//COOLDOWN
+bool BehaviorCooldown::CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state)
+{
+	if (pBlackBoard->GetTime() >= m_ReadyTime)
+		return true;
+
+	state = Failure;
+	return false;
+}
+BehaviorState BehaviorCooldown::HandleChildState(Blackboard* pBlackBoard, BehaviorState childState)
+{
+	if (childState != Running)
+		m_ReadyTime = pBlackBoard->GetTime() + m_Cooldown;
+	return childState;
+}
+//TIME LIMIT
+bool BehaviorTimeLimit::CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state)
+{
+	if (!m_IsRunning || pBlackBoard->GetTick() != m_LastTick + 1)
+	{
+		m_StartTime = pBlackBoard->GetTime();
+		return true;
+	}
+	if (pBlackBoard->GetTime() - m_StartTime < m_TimeLimit)
+		return true;
+
+	m_IsRunning = false;
+	state = Failure;
+	return false;
+}
+BehaviorState BehaviorTimeLimit::HandleChildState(Blackboard* pBlackBoard, BehaviorState childState)
+{
+	m_IsRunning = childState == Running;
+	m_LastTick = pBlackBoard->GetTick();
+	return childState;
+}
+//THROTTLE
+bool BehaviorThrottle::CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state)
+{
+	if (!m_HasState || pBlackBoard->GetTime() >= m_NextTime)
+	{
+		m_NextTime = pBlackBoard->GetTime() + m_Interval;
+		return true;
+	}
+
+	state = m_CurrentState;
+	return false;
+}
+BehaviorState BehaviorThrottle::HandleChildState(Blackboard*, BehaviorState childState)
+{
+	m_HasState = true;
+	return m_CurrentState = childState;
+}
+//RUN EVERY N
+bool BehaviorRunEveryN::CanExecuteChild(Blackboard*, BehaviorState& state)
+{
+	if (!m_HasState || ++m_SkippedCount >= m_N)
+	{
+		m_SkippedCount = 0;
+		return true;
+	}
+
+	state = m_CurrentState;
+	return false;
+}
+BehaviorState BehaviorRunEveryN::HandleChildState(Blackboard*, BehaviorState childState)
+{
+	m_HasState = true;
+	return m_CurrentState = childState;
+}
 #pragma endregion
 //-----------------------------------------------------------------
 // BEHAVIOR TREE CONDITIONAL (IBehavior)
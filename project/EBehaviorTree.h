@@ -55,31 +55,46 @@ namespace Elite
 		}
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override = 0;
+		const std::vector<IBehavior*>& GetChildren() const
+		{ return m_ChildrenBehaviors; }
 
 	protected:
 		std::vector<IBehavior*> m_ChildrenBehaviors = {};
 	};
 
 	//--- SELECTOR ---
+	//isResumingRunning: continue with the Running child next tick instead of re-checking the children before it
 	class BehaviorSelector : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSelector(std::vector<IBehavior*> childrenBehaviors) :
-			BehaviorComposite(childrenBehaviors) {}
+		explicit BehaviorSelector(std::vector<IBehavior*> childrenBehaviors, bool isResumingRunning = false) :
+			BehaviorComposite(childrenBehaviors), m_IsResumingRunning(isResumingRunning) {}
 		virtual ~BehaviorSelector() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		bool IsResumingRunning() const
+		{ return m_IsResumingRunning; }
+
+	private:
+		bool m_IsResumingRunning = false;
+		unsigned int m_RunningBehaviorIndex = 0;
 	};
 
 	//--- SEQUENCE ---
 	class BehaviorSequence : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSequence(std::vector<IBehavior*> childrenBehaviors) :
-			BehaviorComposite(childrenBehaviors) {}
+		explicit BehaviorSequence(std::vector<IBehavior*> childrenBehaviors, bool isResumingRunning = false) :
+			BehaviorComposite(childrenBehaviors), m_IsResumingRunning(isResumingRunning) {}
 		virtual ~BehaviorSequence() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		bool IsResumingRunning() const
+		{ return m_IsResumingRunning; }
+
+	private:
+		bool m_IsResumingRunning = false;
+		unsigned int m_RunningBehaviorIndex = 0;
 	};
 
 	//--- PARTIAL SEQUENCE ---
@@ -95,6 +110,178 @@ namespace Elite
 	private:
 		unsigned int m_CurrentBehaviorIndex = 0;
 	};
+
+	//--- UTILITY SELECTOR ---
+	//Response curve on one input: y = Clamp(Slope * x^(1 or 2) + Offset, 0, 1), x = input mapped from [Min, Max] to [0, 1]
+	struct UtilityConsideration
+	{
+		unsigned int Input = 0; //Index in the inputs of the selector
+		float Min = 0.f;
+		float Max = 1.f;
+		float Slope = 1.f;
+		float Offset = 0.f;
+		bool IsQuadratic = false;
+	};
+
+	//Score = Weight * product of the considerations, a child without considerations always scores its weight
+	struct UtilityOption
+	{
+		IBehavior* pBehavior = nullptr;
+		std::vector<UtilityConsideration> Considerations = {};
+		float Weight = 1.f;
+	};
+
+	//Instead of trying the children in priority order, every input is read once, all children are scored in one pass
+	//and the children are tried from the highest score down until one succeeds or runs. Children scoring 0 are skipped.
+	class BehaviorUtilitySelector : public BehaviorComposite
+	{
+	public:
+		explicit BehaviorUtilitySelector(std::vector<std::function<float(Blackboard*)>> inputs, std::vector<UtilityOption> options);
+		virtual ~BehaviorUtilitySelector() = default;
+
+		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		const std::vector<float>& GetScores() const
+		{ return m_Scores; }
+
+	private:
+		std::vector<std::function<float(Blackboard*)>> m_fpInputs = {};
+		std::vector<float> m_Inputs = {};
+		std::vector<float> m_Scores = {};
+		std::vector<size_t> m_Order = {}; //Child indices, sorted on score every tick
+
+		//Considerations of all children stored per member, the ones of child i are [m_ConsiderationEnds[i-1], m_ConsiderationEnds[i])
+		std::vector<unsigned int> m_ConsiderationEnds = {};
+		std::vector<unsigned int> m_InputIndices = {};
+		std::vector<float> m_Mins = {};
+		std::vector<float> m_InvRanges = {};
+		std::vector<float> m_Slopes = {};
+		std::vector<float> m_Offsets = {};
+		std::vector<float> m_Exponents = {}; //0 == linear, 1 == quadratic
+		std::vector<float> m_Weights = {};
+		std::vector<float> m_Responses = {};
+	};
+#pragma endregion
+
+	//-----------------------------------------------------------------
+	// BEHAVIOR TREE DECORATORS (IBehavior)
+	//-----------------------------------------------------------------
+#pragma region DECORATORS
+	//--- DECORATOR BASE ---
+	//Wraps a single child. Time based decorators use the time of the blackboard, which the tree advances every update.
+	class BehaviorDecorator : public IBehavior
+	{
+	public:
+		explicit BehaviorDecorator(IBehavior* pChildBehavior) : m_pChildBehavior(pChildBehavior) {}
+		virtual ~BehaviorDecorator()
+		{ SAFE_DELETE(m_pChildBehavior); }
+
+		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		IBehavior* GetChild() const
+		{ return m_pChildBehavior; }
+
+		//Split in two so a flattened tree can run the child in between.
+		//Returns false if the child should not run this tick, state is then the result of the decorator.
+		virtual bool CanExecuteChild(Blackboard*, BehaviorState&) { return true; }
+		//Turns the state of the child into the state of the decorator
+		virtual BehaviorState HandleChildState(Blackboard*, BehaviorState childState) { return childState; }
+
+	protected:
+		IBehavior* m_pChildBehavior = nullptr;
+	};
+
+	//--- INVERTER ---
+	class BehaviorInverter final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorInverter(IBehavior* pChildBehavior) : BehaviorDecorator(pChildBehavior) {}
+
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+	};
+
+	//--- REPEAT ---
+	//Runs the child again next tick after every Success until it succeeded repeatCount times (0 = forever), Failure aborts
+	class BehaviorRepeat final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorRepeat(IBehavior* pChildBehavior, unsigned int repeatCount = 0)
+			: BehaviorDecorator(pChildBehavior), m_RepeatCount(repeatCount) {}
+
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+
+	private:
+		unsigned int m_RepeatCount = 0;
+		unsigned int m_SuccessCount = 0;
+	};
+
+	//--- COOLDOWN ---
+	//Fails without running the child for cooldown seconds after the child finished
+	class BehaviorCooldown final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorCooldown(IBehavior* pChildBehavior, float cooldown)
+			: BehaviorDecorator(pChildBehavior), m_Cooldown(cooldown) {}
+
+		virtual bool CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state) override;
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+
+	private:
+		float m_Cooldown = 0.f;
+		float m_ReadyTime = 0.f;
+	};
+
+	//--- TIME LIMIT ---
+	//Fails once the child has been Running for longer than timeLimit seconds.
+	//A child that wasn't executed last update was aborted, it starts over.
+	class BehaviorTimeLimit final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorTimeLimit(IBehavior* pChildBehavior, float timeLimit)
+			: BehaviorDecorator(pChildBehavior), m_TimeLimit(timeLimit) {}
+
+		virtual bool CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state) override;
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+
+	private:
+		float m_TimeLimit = 0.f;
+		float m_StartTime = 0.f;
+		unsigned int m_LastTick = 0;
+		bool m_IsRunning = false;
+	};
+
+	//--- THROTTLE ---
+	//Runs the child at most once every interval seconds, returns the last state of the child in between (like RunEveryN).
+	//That state can be up to interval seconds old, the child's blackboard writes (f.e. the target) stay in place meanwhile.
+	class BehaviorThrottle final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorThrottle(IBehavior* pChildBehavior, float interval)
+			: BehaviorDecorator(pChildBehavior), m_Interval(interval) {}
+
+		virtual bool CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state) override;
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+
+	private:
+		float m_Interval = 0.f;
+		float m_NextTime = 0.f;
+		bool m_HasState = false;
+	};
+
+	//--- RUN EVERY N ---
+	//Runs the child every n-th time the decorator is executed, returns the last state of the child in between
+	class BehaviorRunEveryN final : public BehaviorDecorator
+	{
+	public:
+		explicit BehaviorRunEveryN(IBehavior* pChildBehavior, unsigned int n)
+			: BehaviorDecorator(pChildBehavior), m_N(n) {}
+
+		virtual bool CanExecuteChild(Blackboard* pBlackBoard, BehaviorState& state) override;
+		virtual BehaviorState HandleChildState(Blackboard* pBlackBoard, BehaviorState childState) override;
+
+	private:
+		unsigned int m_N = 1;
+		unsigned int m_SkippedCount = 0;
+		bool m_HasState = false;
+	};
 #pragma endregion
 
 	//-----------------------------------------------------------------
@@ -104,10 +291,19 @@ namespace Elite
 	{
 	public:
 		explicit BehaviorConditional(std::function<bool(Blackboard*)> fp) : m_fpConditional(fp) {}
+		//readKeys: all blackboard data the conditional reads. Only declare these for conditionals without side effects,
+		//a reactive tree reuses the previous result (and skips the call) as long as none of these keys changed.
+		explicit BehaviorConditional(std::function<bool(Blackboard*)> fp, std::vector<std::string> readKeys)
+			: m_fpConditional(fp), m_ReadKeys(readKeys) {}
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		const std::function<bool(Blackboard*)>& GetConditional() const
+		{ return m_fpConditional; }
+		const std::vector<std::string>& GetReadKeys() const
+		{ return m_ReadKeys; }
 
 	private:
 		std::function<bool(Blackboard*)> m_fpConditional = nullptr;
+		std::vector<std::string> m_ReadKeys = {};
 	};
 
 	//-----------------------------------------------------------------
@@ -118,6 +314,8 @@ namespace Elite
 	public:
 		explicit BehaviorAction(std::function<BehaviorState(Blackboard*)> fp) : m_fpAction(fp) {}
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+		const std::function<BehaviorState(Blackboard*)>& GetAction() const
+		{ return m_fpAction; }
 
 	private:
 		std::function<BehaviorState(Blackboard*)> m_fpAction = nullptr;
@@ -145,6 +343,7 @@ namespace Elite
 				return;
 			}
 				
+			m_pBlackBoard->AdvanceTime(deltaTime);
 			m_CurrentState = m_pRootComposite->Execute(m_pBlackBoard);
 		}
 		Blackboard* GetBlackboard() const
@@ -21,6 +21,13 @@ namespace Elite
 	public:
 		IBlackBoardField() = default;
 		virtual ~IBlackBoardField() = default;
+
+		//Blackboard version at the moment this field was last changed
+		unsigned int GetVersion() const { return m_Version; }
+		void SetVersion(unsigned int version) { m_Version = version; }
+
+	private:
+		unsigned int m_Version = 0;
 	};
 
 	//BlackboardField does not take ownership of pointers whatsoever!
@@ -73,6 +80,7 @@ namespace Elite
 				if (p)
 				{
 					p->SetData(data);
+					p->SetVersion(++m_Version);
 					return true;
 				}
 			}
@@ -93,8 +101,42 @@ namespace Elite
 			return false;
 		}
 
+		//Flag data as changed without setting it (f.e. containers modified through a stored pointer)
+		bool MarkChanged(const std::string& name)
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it != m_BlackboardData.end() && it->second)
+			{
+				it->second->SetVersion(++m_Version);
+				return true;
+			}
+			printf("WARNING: Data '%s' not found in Blackboard \n", name.c_str());
+			return false;
+		}
+
+		//Get the field itself, used to track its version without a lookup every time
+		const IBlackBoardField* GetField(const std::string& name) const
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it != m_BlackboardData.end())
+				return it->second;
+			return nullptr;
+		}
+
+		//Incremented on every change, so a field changed after version V has a version > V
+		unsigned int GetVersion() const { return m_Version; }
+
+		//Time the owning decision making has been running, used by time based behaviors (not a field, changing it has no version)
+		void AdvanceTime(float deltaTime) { m_Time += deltaTime; ++m_Tick; }
+		float GetTime() const { return m_Time; }
+		//Updates so far, lets a behavior tell whether it was executed last update
+		unsigned int GetTick() const { return m_Tick; }
+
 	private:
 		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+		unsigned int m_Version = 0;
+		float m_Time = 0.f;
+		unsigned int m_Tick = 0;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,296 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EFlatBehaviorTree.h"
+using namespace Elite;
+
+//-----------------------------------------------------------------
+// FLAT BEHAVIOR TREE
+//-----------------------------------------------------------------
+FlatBehaviorTree::FlatBehaviorTree(Blackboard* pBlackBoard, IBehavior* pRootComposite)
+	: m_pBlackBoard(pBlackBoard), m_pRootComposite(pRootComposite)
+{
+	if (m_pRootComposite == nullptr)
+		return;
+
+	Compile(m_pRootComposite, 1);
+	assert(m_Nodes.size() <= (std::numeric_limits<unsigned short>::max)() && "<FlatBehaviorTree>: too many nodes to address");
+	m_ChildCursors.resize(m_Nodes.size(), 0);
+	m_VisitedConditions.reserve(m_Nodes.size());
+}
+
+#pragma region COMPILING
+void FlatBehaviorTree::Compile(IBehavior* pBehavior, size_t depth)
+{
+	//Reserve own slot first (pre-order), fill it in once the children are emitted
+	const size_t index = m_Nodes.size();
+	m_Nodes.push_back(FlatBehaviorNode{});
+	m_ConditionCaches.push_back(ConditionCache{});
+	if (m_Stack.size() < depth)
+		m_Stack.resize(depth);
+
+	FlatBehaviorNode node{};
+	node.pBehavior = pBehavior;
+
+	if (const auto pComposite = dynamic_cast<BehaviorComposite*>(pBehavior))
+	{
+		//Partial sequence derives from sequence, check it first
+		if (dynamic_cast<BehaviorPartialSequence*>(pBehavior))
+			node.Type = FlatBehaviorType::PartialSequence;
+		else if (const auto pSequence = dynamic_cast<BehaviorSequence*>(pBehavior))
+		{
+			node.Type = FlatBehaviorType::Sequence;
+			node.IsResumingRunning = pSequence->IsResumingRunning();
+		}
+		else if (const auto pSelector = dynamic_cast<BehaviorSelector*>(pBehavior))
+		{
+			node.Type = FlatBehaviorType::Selector;
+			node.IsResumingRunning = pSelector->IsResumingRunning();
+		}
+
+		//Unknown composites run as a whole through IBehavior::Execute, their children are not flattened
+		if (node.Type != FlatBehaviorType::Behavior)
+		{
+			node.ChildCount = static_cast<unsigned short>(pComposite->GetChildren().size());
+			for (auto pChild : pComposite->GetChildren())
+				Compile(pChild, depth + 1);
+		}
+	}
+	else if (const auto pDecorator = dynamic_cast<BehaviorDecorator*>(pBehavior))
+	{
+		if (pDecorator->GetChild())
+		{
+			node.Type = FlatBehaviorType::Decorator;
+			node.ChildCount = 1;
+			Compile(pDecorator->GetChild(), depth + 1);
+		}
+	}
+	else if (const auto pConditional = dynamic_cast<BehaviorConditional*>(pBehavior))
+	{
+		//Only plain functions can be stored as function pointer, everything else keeps the std::function
+		const auto fp = pConditional->GetConditional().target<BehaviorConditionalFn>();
+		if (fp && *fp)
+		{
+			node.Type = FlatBehaviorType::Conditional;
+			node.fpConditional = *fp;
+
+			//Resolve the read keys to their fields once, a conditional with an unknown key is never cached
+			const auto& readKeys = pConditional->GetReadKeys();
+			ConditionCache cache{};
+			cache.DependencyBegin = static_cast<unsigned short>(m_Dependencies.size());
+			bool isTracked = m_pBlackBoard != nullptr && !readKeys.empty();
+			for (size_t i = 0; i < readKeys.size() && isTracked; ++i)
+			{
+				const IBlackBoardField* pField = m_pBlackBoard->GetField(readKeys[i]);
+				if (pField == nullptr)
+				{
+					printf("WARNING: Conditional reads unknown key '%s', result will not be cached \n", readKeys[i].c_str());
+					isTracked = false;
+				}
+				m_Dependencies.push_back(pField);
+			}
+			if (isTracked)
+				cache.DependencyCount = static_cast<unsigned short>(readKeys.size());
+			else
+				m_Dependencies.resize(cache.DependencyBegin);
+			m_ConditionCaches[index] = cache;
+		}
+	}
+	else if (const auto pAction = dynamic_cast<BehaviorAction*>(pBehavior))
+	{
+		const auto fp = pAction->GetAction().target<BehaviorActionFn>();
+		if (fp && *fp)
+		{
+			node.Type = FlatBehaviorType::Action;
+			node.fpAction = *fp;
+		}
+	}
+
+	node.SubtreeEnd = static_cast<unsigned short>(m_Nodes.size());
+	m_Nodes[index] = node;
+}
+#pragma endregion
+
+#pragma region EXECUTION
+//Same semantics as the composites in EBehaviorTree.cpp, but iterative:
+//entering a composite pushes a frame, a finished child hands its state back to the frame on top
+BehaviorState FlatBehaviorTree::Execute(Blackboard* pBlackBoard)
+{
+	const FlatBehaviorNode* pNodes = m_Nodes.data();
+	Frame* pStack = m_Stack.data();
+	int top = -1;
+	unsigned short current = 0;
+	BehaviorState state = Failure;
+
+	//Reactive: jump straight back into last tick's Running leaf if nothing it depended on changed
+	assert((!m_IsReactive || pBlackBoard == m_pBlackBoard) && "<FlatBehaviorTree>: reactive mode tracks its own blackboard only");
+	bool isPathCached = m_IsReactive; //Only cached conditionals were executed before the current leaf
+	if (m_IsReactive && m_CanResume && CanResume())
+	{
+		top = m_ResumeTop;
+		current = m_ResumeNode;
+	}
+	else
+		m_VisitedConditions.clear();
+	m_CanResume = false;
+
+	for (;;)
+	{
+		//--- Enter node ---
+		const FlatBehaviorNode& node = pNodes[current];
+		switch (node.Type)
+		{
+		case FlatBehaviorType::Selector:
+		case FlatBehaviorType::Sequence:
+			if (node.ChildCount > 0)
+			{
+				unsigned short child = current + 1;
+				if (node.IsResumingRunning && m_ChildCursors[current] != 0)
+				{
+					child = m_ChildCursors[current];
+					m_ChildCursors[current] = 0;
+				}
+				pStack[++top] = { current, child };
+				current = child;
+				continue;
+			}
+			state = node.Type == FlatBehaviorType::Selector ? Failure : Success;
+			break;
+		case FlatBehaviorType::PartialSequence:
+		{
+			const unsigned short child = m_ChildCursors[current] != 0 ? m_ChildCursors[current] : current + 1;
+			if (child < node.SubtreeEnd)
+			{
+				pStack[++top] = { current, child };
+				current = child;
+				continue;
+			}
+			//Resetting changes which child is entered next tick, so the path can't be resumed
+			isPathCached = isPathCached && m_ChildCursors[current] == 0;
+			m_ChildCursors[current] = 0;
+			state = Success;
+			break;
+		}
+		case FlatBehaviorType::Decorator:
+			//Decorators keep their own state, a path through one is never resumed directly
+			isPathCached = false;
+			if (node.pDecorator->CanExecuteChild(pBlackBoard, state))
+			{
+				pStack[++top] = { current, static_cast<unsigned short>(current + 1) };
+				++current;
+				continue;
+			}
+			break;
+		case FlatBehaviorType::Conditional:
+			if (m_IsReactive && m_ConditionCaches[current].DependencyCount > 0)
+			{
+				ConditionCache& cache = m_ConditionCaches[current];
+				if (IsDirty(cache))
+				{
+					cache.EvaluatedVersion = pBlackBoard->GetVersion();
+					cache.Result = node.fpConditional(pBlackBoard);
+					cache.IsValid = true;
+				}
+				state = cache.Result ? Success : Failure;
+				if (isPathCached)
+					m_VisitedConditions.push_back(current);
+				break;
+			}
+			state = node.fpConditional(pBlackBoard) ? Success : Failure;
+			isPathCached = false;
+			break;
+		case FlatBehaviorType::Action:
+			state = node.fpAction(pBlackBoard);
+			break;
+		case FlatBehaviorType::Behavior:
+			state = node.pBehavior->Execute(pBlackBoard);
+			break;
+		}
+
+		//A Running leaf ends the tick, remember how to get back to it
+		if (state == Running && isPathCached && node.Type != FlatBehaviorType::Conditional)
+		{
+			m_CanResume = true;
+			m_ResumeNode = current;
+			m_ResumeTop = top;
+		}
+		if (node.Type == FlatBehaviorType::Action || node.Type == FlatBehaviorType::Behavior)
+			isPathCached = false;
+
+		//--- Hand the state back up until a composite wants to run its next child ---
+		bool isDescending = false;
+		while (top >= 0 && !isDescending)
+		{
+			Frame& frame = pStack[top];
+			const FlatBehaviorNode& parent = pNodes[frame.Node];
+			const unsigned short next = pNodes[frame.Child].SubtreeEnd;
+
+			switch (parent.Type)
+			{
+			case FlatBehaviorType::Selector:
+				isDescending = state == Failure && next < parent.SubtreeEnd;
+				if (parent.IsResumingRunning)
+					m_ChildCursors[frame.Node] = state == Running ? frame.Child : 0;
+				break;
+			case FlatBehaviorType::Sequence:
+				isDescending = state == Success && next < parent.SubtreeEnd;
+				if (parent.IsResumingRunning)
+					m_ChildCursors[frame.Node] = state == Running ? frame.Child : 0;
+				break;
+			case FlatBehaviorType::PartialSequence:
+				if (state == Failure)
+				{
+					isPathCached = isPathCached && m_ChildCursors[frame.Node] == 0;
+					m_ChildCursors[frame.Node] = 0;
+				}
+				else if (state == Success)
+				{
+					m_ChildCursors[frame.Node] = next;
+					state = Running;
+				}
+				break;
+			case FlatBehaviorType::Decorator:
+				state = parent.pDecorator->HandleChildState(pBlackBoard, state);
+				break;
+			default:
+				break;
+			}
+
+			if (isDescending)
+			{
+				frame.Child = next;
+				current = next;
+			}
+			else
+				--top;
+		}
+
+		if (!isDescending)
+			return state;
+	}
+}
+
+bool FlatBehaviorTree::IsDirty(const ConditionCache& cache) const
+{
+	if (!cache.IsValid)
+		return true;
+
+	const auto pDependencies = m_Dependencies.data() + cache.DependencyBegin;
+	for (unsigned short i = 0; i < cache.DependencyCount; ++i)
+	{
+		if (pDependencies[i]->GetVersion() > cache.EvaluatedVersion)
+			return true;
+	}
+	return false;
+}
+
+bool FlatBehaviorTree::CanResume() const
+{
+	//Every conditional that led to the Running leaf has to give the same result as last tick
+	for (auto node : m_VisitedConditions)
+	{
+		if (IsDirty(m_ConditionCaches[node]))
+			return false;
+	}
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,131 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EFlatBehaviorTree.h: "Compiled" version of a BehaviorTree. The IBehavior graph is
+// flattened into one contiguous pre-order array and executed by an iterative loop.
+/*=============================================================================*/
+#ifndef ELITE_FLAT_BEHAVIOR_TREE
+#define ELITE_FLAT_BEHAVIOR_TREE
+
+//--- Includes ---
+#include "EBehaviorTree.h"
+
+namespace Elite
+{
+	//=== Options ===
+	#define USE_FLAT_BEHAVIOR_TREE
+
+	//-----------------------------------------------------------------
+	// FLAT BEHAVIOR TREE HELPERS
+	//-----------------------------------------------------------------
+	typedef bool(*BehaviorConditionalFn)(Blackboard*);
+	typedef BehaviorState(*BehaviorActionFn)(Blackboard*);
+
+	enum class FlatBehaviorType : unsigned char
+	{
+		Selector,
+		Sequence,
+		PartialSequence,
+		Decorator, //Single child, the decorator itself is called before and after the child
+		Conditional,
+		Action,
+		Behavior //Node that can't be flattened (custom IBehavior, capturing lambda), executed through IBehavior::Execute
+	};
+
+	//Nodes are stored in pre-order: the children of a composite directly follow it.
+	//SubtreeEnd is the index one past the last node of the subtree, which is also the index of the next sibling.
+	struct FlatBehaviorNode final
+	{
+		FlatBehaviorType Type = FlatBehaviorType::Behavior;
+		bool IsResumingRunning = false;
+		unsigned short SubtreeEnd = 0;
+		unsigned short ChildCount = 0;
+		union
+		{
+			BehaviorConditionalFn fpConditional = nullptr;
+			BehaviorActionFn fpAction;
+			IBehavior* pBehavior;
+			BehaviorDecorator* pDecorator;
+		};
+	};
+
+	//-----------------------------------------------------------------
+	// FLAT BEHAVIOR TREE
+	//-----------------------------------------------------------------
+	class FlatBehaviorTree final : public Elite::IDecisionMaking
+	{
+	public:
+		explicit FlatBehaviorTree(Blackboard* pBlackBoard, IBehavior* pRootComposite);
+		~FlatBehaviorTree()
+		{
+			SAFE_DELETE(m_pRootComposite); //Keeps the source tree alive for the Behavior nodes
+			SAFE_DELETE(m_pBlackBoard); //Takes ownership of passed blackboard!
+		};
+
+		virtual void Update(float deltaTime) override
+		{
+			if (m_Nodes.empty())
+			{
+				m_CurrentState = Failure;
+				return;
+			}
+
+			m_pBlackBoard->AdvanceTime(deltaTime);
+			m_CurrentState = Execute(m_pBlackBoard);
+		}
+		BehaviorState Execute(Blackboard* pBlackBoard);
+
+		//Reactive mode: conditionals that declared their read keys are only re-evaluated when one of those keys changed,
+		//and a Running leaf that was reached through cached conditionals only is resumed without traversing from the root.
+		//Caching is tracked on the blackboard passed on construction.
+		void SetReactive(bool isReactive)
+		{ m_IsReactive = isReactive; m_CanResume = false; }
+		bool IsReactive() const
+		{ return m_IsReactive; }
+
+		Blackboard* GetBlackboard() const
+		{ return m_pBlackBoard; }
+		const std::vector<FlatBehaviorNode>& GetNodes() const
+		{ return m_Nodes; }
+
+	private:
+		//Composite currently being iterated and the child it is executing
+		struct Frame
+		{
+			unsigned short Node;
+			unsigned short Child;
+		};
+
+		//Last result of a conditional with declared read keys, indexed by node
+		struct ConditionCache
+		{
+			unsigned short DependencyBegin = 0;
+			unsigned short DependencyCount = 0; //0 == not cached
+			unsigned int EvaluatedVersion = 0;
+			bool IsValid = false;
+			bool Result = false;
+		};
+
+		BehaviorState m_CurrentState = Failure;
+		Blackboard* m_pBlackBoard = nullptr;
+		IBehavior* m_pRootComposite = nullptr;
+
+		std::vector<FlatBehaviorNode> m_Nodes = {};
+		std::vector<unsigned short> m_ChildCursors = {}; //Child to continue with for partial sequences and resuming composites (0 == first child), indexed by node
+		std::vector<Frame> m_Stack = {}; //Sized to the depth of the tree, reused every tick
+
+		//Reactive mode
+		bool m_IsReactive = false;
+		std::vector<ConditionCache> m_ConditionCaches = {};
+		std::vector<const IBlackBoardField*> m_Dependencies = {};
+		std::vector<unsigned short> m_VisitedConditions = {}; //Cached conditionals checked on the way to the Running leaf
+		bool m_CanResume = false;
+		unsigned short m_ResumeNode = 0; //Running leaf of the previous tick
+		int m_ResumeTop = -1; //Top of the frame stack when that leaf was entered, frames stay intact while Running propagates up
+
+		void Compile(IBehavior* pBehavior, size_t depth);
+		bool IsDirty(const ConditionCache& cache) const;
+		bool CanResume() const;
+	};
+}
+#endif
@@ -8,6 +8,7 @@
 //#include "EGeometry.h"
 #include "EGeometry2DTypes.h"
 #include "EGeometry2DUtilities.h"
+#include "ETriangulation.h"
 
 #pragma region Polygon
 #pragma region Constructors
@@ -44,16 +45,37 @@ Elite::Polygon::Polygon(const Vector2* vertices, int count)
 		m_vPoints.push_back(vertices[i]);
 }
 
-Elite::Polygon::~Polygon()
+Elite::Polygon::Polygon(const Polygon& p)
+	: m_vChildren(p.m_vChildren)
+	, m_vPoints(p.m_vPoints)
+	, m_MeshVertices(p.m_MeshVertices)
+	, m_TriangleVertices(p.m_TriangleVertices)
+	, m_Triangles(p.m_Triangles)
+	, m_LineVertices(p.m_LineVertices)
+	, m_Lines(p.m_Lines)
+	, m_isTriangulated(p.m_isTriangulated)
+#ifdef USE_TRIANGLE_METADATA
+	, m_LineIndices(p.m_LineIndices)
+	, m_LineTriangles(p.m_LineTriangles)
+#endif
+#ifdef USE_POINT_LOCATION_GRID
+	, m_GridOrigin(p.m_GridOrigin)
+	, m_GridInvCellSize(p.m_GridInvCellSize)
+	, m_GridColumns(p.m_GridColumns)
+	, m_GridRows(p.m_GridRows)
+	, m_GridCellStarts(p.m_GridCellStarts)
+	, m_GridTriangles(p.m_GridTriangles)
+#endif
 {
-	m_vPoints.clear();
-	m_vChildren.clear();
-	for (auto t : m_vpTriangles)
-		SAFE_DELETE(t);
-	m_vpTriangles.clear();
-	for (auto l : m_vpLines)
-		SAFE_DELETE(l);
-	m_vpLines.clear();
+	UpdateMeshViews();
+}
+
+Elite::Polygon& Elite::Polygon::operator=(const Polygon& p)
+{
+	//Moving keeps the buffers, so the views of the copy stay valid
+	Polygon copy(p);
+	*this = std::move(copy);
+	return *this;
 }
 #pragma endregion //Constructors
 //----------------------------------------------------------
@@ -106,6 +128,15 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::GetTriangles() const
 
 const std::vector<Elite::Line*>& Elite::Polygon::GetLines() const
 { return m_vpLines; }
+
+const std::vector<Elite::Vector2>& Elite::Polygon::GetMeshVertices() const
+{ return m_MeshVertices; }
+
+const std::vector<std::array<int, 3>>& Elite::Polygon::GetTriangleVertices() const
+{ return m_TriangleVertices; }
+
+const std::vector<std::array<int, 2>>& Elite::Polygon::GetLineVertices() const
+{ return m_LineVertices; }
 #pragma endregion //MemberAccess
 //----------------------------------------------------------
 #pragma region GettersInformation
@@ -165,9 +196,20 @@ bool Elite::Polygon::OverlappingYAxis(const Polygon& poly) const
 
 std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTriangles(const Triangle* t) const
 {
+	std::vector<Triangle*> adjTriangles;
+#ifdef USE_TRIANGLE_METADATA
+	//The other triangle on each of its lines
+	for (const auto lineIndex : t->metaData.IndexLines)
+	{
+		for (const auto triangleIndex : m_LineTriangles[lineIndex])
+		{
+			if (triangleIndex != -1 && triangleIndex != t->metaData.Index)
+				adjTriangles.push_back(m_vpTriangles[triangleIndex]);
+		}
+	}
+#else
 	//For this triangle, go over all triangles and look if any of it's edges matches the edges of a triangle,
 	//in other words, two points overlap. If two points match, it's an adjacent triangle
-	std::vector<Triangle*> adjTriangles;
 	for (auto ct : m_vpTriangles)
 	{
 		if (t == ct) //If same triangle, ignore
@@ -186,6 +228,7 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTriangles(const Triangl
 		if (matchingVerts == 2)
 			adjTriangles.push_back(ct);
 	}
+#endif
 	return adjTriangles;
 }
 
@@ -196,27 +239,26 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTrianglesOnLine(const T
 	std::vector<Triangle*> adjTriangles;
 
 #ifdef USE_TRIANGLE_METADATA
-	//Start by getting index of line in matrix
-	auto lRev = Line(l.p2, l.p1);
-	const auto it = std::find_if(m_vpLines.begin(), m_vpLines.end(), [&](const Line* rl)
-	{ return (*rl == l || *rl == lRev); });
-	if (it == m_vpLines.end())
+	//Start by getting index of line in matrix, usually it's one of the lines of the triangle
+	auto lineIndex = -1;
+	for (const auto i : t->metaData.IndexLines)
+	{
+		if (i != -1 && (m_Lines[i] == l || m_Lines[i] == Line(l.p2, l.p1)))
+			lineIndex = i;
+	}
+	if (lineIndex == -1)
+		lineIndex = GetLineIndex(l);
+	if (lineIndex == -1)
 	{
 		std::cout << "WARNING: line not found!" << std::endl;
 		return adjTriangles;
 	}
-	const int lineIndex = it - m_vpLines.begin();
 
-	//Go over all the triangles and compare lines
-	for (auto ct : m_vpTriangles)
+	//The triangles on the line, except this one
+	for (const auto triangleIndex : m_LineTriangles[lineIndex])
 	{
-		if (t == ct) //If same triangle, ignore
-			continue;
-
-		if (ct->metaData.IndexLines[0] == lineIndex
-			|| ct->metaData.IndexLines[1] == lineIndex
-			|| ct->metaData.IndexLines[2] == lineIndex)
-			adjTriangles.push_back(ct);
+		if (triangleIndex != -1 && m_vpTriangles[triangleIndex] != t)
+			adjTriangles.push_back(m_vpTriangles[triangleIndex]);
 	}
 #endif
 	return adjTriangles;
@@ -225,29 +267,86 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTrianglesOnLine(const T
 
 const Elite::Triangle* Elite::Polygon::GetTriangleFromPosition(const Vector2& position, bool onLineAllowed /*= false*/) const
 {
-	for (size_t i = 0; i < m_vpTriangles.size(); i++)
+#ifdef USE_POINT_LOCATION_GRID
+	if (!m_GridCellStarts.empty())
 	{
-		if (PointInTriangle(position, m_vpTriangles[i]->p1, m_vpTriangles[i]->p2, m_vpTriangles[i]->p3, onLineAllowed))
-			return m_vpTriangles[i];
+		int column, row;
+		GetGridCell(position, column, row);
+		if (column < 0 || column >= m_GridColumns || row < 0 || row >= m_GridRows)
+			return nullptr;
+
+		const auto cell = row * m_GridColumns + column;
+		for (auto i = m_GridCellStarts[cell]; i < m_GridCellStarts[cell + 1]; ++i)
+		{
+			const auto& t = m_Triangles[m_GridTriangles[i]];
+			if (PointInTriangle(position, t.p1, t.p2, t.p3, onLineAllowed))
+				return &t;
+		}
+		return nullptr;
+	}
+#endif
+	for (const auto& t : m_Triangles)
+	{
+		if (PointInTriangle(position, t.p1, t.p2, t.p3, onLineAllowed))
+			return &t;
 	}
 	return nullptr;
 }
 
+const Elite::Triangle* Elite::Polygon::GetTriangleFromPositionNear(const Vector2& position, const Triangle* pHint, bool onLineAllowed /*= false*/) const
+{
+#ifdef USE_TRIANGLE_METADATA
+	//Cross the line the position lies behind until the triangle contains it. The step limit
+	//catches walks that leave the mesh or go around in circles (possible on non Delaunay meshes)
+	const auto maxSteps = 16;
+	auto t = pHint;
+	for (auto step = 0; t && step < maxSteps; ++step)
+	{
+		if (PointInTriangle(position, t->p1, t->p2, t->p3, onLineAllowed))
+			return t;
+
+		const std::array<Vector2, 3> points{ { t->p1, t->p2, t->p3 } };
+		const auto orientation = Cross(t->p2 - t->p1, t->p3 - t->p1) < 0.f ? -1.f : 1.f;
+		auto exitLine = -1;
+		for (auto i = 0; i < 3 && exitLine == -1; ++i)
+		{
+			if (orientation * Cross(points[(i + 1) % 3] - points[i], position - points[i]) < 0.f)
+				exitLine = i;
+		}
+		if (exitLine == -1)
+			break; //On a line while that isn't allowed
+
+		const auto& lineTriangles = m_LineTriangles[t->metaData.IndexLines[exitLine]];
+		const auto next = lineTriangles[0] == t->metaData.Index ? lineTriangles[1] : lineTriangles[0];
+		t = next != -1 ? &m_Triangles[next] : nullptr;
+	}
+#endif
+	return GetTriangleFromPosition(position, onLineAllowed);
+}
+
 #ifdef USE_TRIANGLE_METADATA
 const std::vector<const Elite::Triangle*> Elite::Polygon::GetTrianglesFromLineIndex(unsigned int lineIndex) const
 {
 	std::vector<const Triangle*> vpFoundTriangles = {};
-	for (auto pT : m_vpTriangles)
+	if (lineIndex >= m_LineTriangles.size())
+		return vpFoundTriangles;
+	for (const auto triangleIndex : m_LineTriangles[lineIndex])
 	{
-		if (pT->metaData.IndexLines[0] == lineIndex ||
-			pT->metaData.IndexLines[1] == lineIndex ||
-			pT->metaData.IndexLines[2] == lineIndex)
-		{
-			vpFoundTriangles.push_back(pT);
-		}
+		if (triangleIndex != -1)
+			vpFoundTriangles.push_back(m_vpTriangles[triangleIndex]);
 	}
 	return vpFoundTriangles;
 }
+
+int Elite::Polygon::GetLineIndex(const Line& l) const
+{
+	//Lines from GetLines know their index, others are searched on their end points
+	const auto isSameLine = [&l](const Line& ml) { return ml == l || ml == Line(l.p2, l.p1); };
+	if (l.index >= 0 && l.index < static_cast<int>(m_Lines.size()) && isSameLine(m_Lines[l.index]))
+		return l.index;
+	const auto it = std::find_if(m_Lines.begin(), m_Lines.end(), isSameLine);
+	return it != m_Lines.end() ? it->index : -1;
+}
 #endif
 
 
@@ -256,6 +355,9 @@ const std::vector<const Elite::Triangle*> Elite::Polygon::GetTrianglesFromLineIn
 #pragma region TriangulationFunctions
 const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 {
+#ifdef USE_SWEEP_TRIANGULATION
+	return TriangulateSweep();
+#else
 	//Check winding
 	OrientateWithChildren(Winding::CCW);
 
@@ -294,9 +396,8 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 		Split();
 
 	//Triangle list - Clear first (if already containing triangles)
-	for (auto t : m_vpTriangles)
-		SAFE_DELETE(t);
-	m_vpTriangles.clear();
+	m_MeshVertices.clear();
+	m_TriangleVertices.clear();
 
 	std::list<Vector2> copyPoints;
 	copyPoints.assign(m_vPoints.begin(), m_vPoints.end()); //Copy
@@ -316,8 +417,7 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 		//Push triangle
 		Vector2 current, prev, next;
 		GetTriangle(copyPoints, earListIt, current, prev, next);
-		Triangle* t = new Triangle(prev, current, next);
-		m_vpTriangles.push_back(t);
+		m_TriangleVertices.push_back({ { AddMeshVertex(prev), AddMeshVertex(current), AddMeshVertex(next) } });
 
 		//Remove current from pointslist
 		const auto currentIt = std::find(copyPoints.begin(), copyPoints.end(), current);
@@ -327,18 +427,14 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 	std::vector<Vector2> tempCopy;
 	for (const auto p : copyPoints)
 		tempCopy.push_back(p);
-	Triangle* lastTriangle = new Triangle(tempCopy[0], tempCopy[1], tempCopy[2]);
-	m_vpTriangles.push_back(lastTriangle);
+	m_TriangleVertices.push_back({ { AddMeshVertex(tempCopy[0]), AddMeshVertex(tempCopy[1]), AddMeshVertex(tempCopy[2]) } });
 
-	//Flag as triangulated for later use
-	m_isTriangulated = true; 
-
-#ifdef USE_TRIANGLE_METADATA
-	GenerateLineMatrix();
-#endif
+	//Triangles, lines and lookups from the indices, flags as triangulated for later use
+	BuildMesh();
 
 	m_vChildren = children;
 	return m_vpTriangles;
+#endif
 }
 
 void Elite::Polygon::OrientateWithChildren(Winding winding)
@@ -436,52 +532,147 @@ bool Elite::Polygon::IsEar(const list<Vector2>& l, const list<Vector2>::const_it
 	return true;
 }
 
+void Elite::Polygon::BuildMesh()
+{
+	//Triangles from the vertex indices, then the lines, views and lookup structures on top of them
+	m_Triangles.clear();
+	m_Triangles.reserve(m_TriangleVertices.size());
+	for (const auto& vertices : m_TriangleVertices)
+		m_Triangles.emplace_back(m_MeshVertices[vertices[0]], m_MeshVertices[vertices[1]], m_MeshVertices[vertices[2]]);
+
+	GenerateLineMatrix();
+	UpdateMeshViews();
+#ifdef USE_POINT_LOCATION_GRID
+	BuildPointLocationGrid();
+#endif
+	m_isTriangulated = true;
+}
+
+void Elite::Polygon::UpdateMeshViews()
+{
+	m_vpTriangles.resize(m_Triangles.size());
+	for (size_t i = 0; i < m_Triangles.size(); ++i)
+		m_vpTriangles[i] = &m_Triangles[i];
+	m_vpLines.resize(m_Lines.size());
+	for (size_t i = 0; i < m_Lines.size(); ++i)
+		m_vpLines[i] = &m_Lines[i];
+}
+
 void Elite::Polygon::GenerateLineMatrix()
 {
+	m_Lines.clear();
+	m_LineVertices.clear();
 #ifdef USE_TRIANGLE_METADATA
-	//Go over all the triangles
-	for (auto t : m_vpTriangles)
+	m_LineIndices.clear();
+	m_LineTriangles.clear();
+
+	//Every triangle adds its lines, a line that is already in the hash map gets the triangle as its second one
+	//Lines are shared by at most two triangles, so there are at most 3 * triangles lines
+	m_LineIndices.reserve(m_Triangles.size() * 3);
+	for (auto i = 0; i < static_cast<int>(m_Triangles.size()); ++i)
 	{
-		//Go over all the lines of the triangle, search if they are already in the matrix
-		//If not add them and store it's index in the triangles meta data
-		const Line l1{ t->p1, t->p2 };
-		const Line l1rev{ t->p2, t->p1 };
-		const Line l2{ t->p2, t->p3 };
-		const Line l2rev{ t->p3, t->p2 };
-		const Line l3{ t->p3, t->p1 };
-		const Line l3rev{ t->p1, t->p3 };
-		for (auto i = 0; i < static_cast<int>(m_vpLines.size()); ++i)
-		{
-			const auto l = m_vpLines[i];
-			if (*l == l1 || *l == l1rev)
-				t->metaData.IndexLines[0] = i;
-			if (*l == l2 || *l == l2rev)
-				t->metaData.IndexLines[1] = i;
-			if (*l == l3 || *l == l3rev)
-				t->metaData.IndexLines[2] = i;
-		}
-		//Not found, add to matrix
-		if (t->metaData.IndexLines[0] == -1)
-		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p1, t->p2, index));
-			t->metaData.IndexLines[0] = index;
-		}
-		if (t->metaData.IndexLines[1] == -1)
+		auto& t = m_Triangles[i];
+		const auto& vertices = m_TriangleVertices[i];
+		t.metaData.Index = i;
+		t.metaData.IndexLines[0] = AddLine(vertices[0], vertices[1], i);
+		t.metaData.IndexLines[1] = AddLine(vertices[1], vertices[2], i);
+		t.metaData.IndexLines[2] = AddLine(vertices[2], vertices[0], i);
+	}
+#endif
+}
+
+#ifdef USE_TRIANGLE_METADATA
+unsigned long long Elite::Polygon::GetLineKey(int vertex1, int vertex2)
+{
+	//Smallest index first so both directions give the same key
+	return static_cast<unsigned long long>((std::min)(vertex1, vertex2)) << 32 | static_cast<unsigned int>((std::max)(vertex1, vertex2));
+}
+
+int Elite::Polygon::AddLine(int vertex1, int vertex2, int triangleIndex)
+{
+	const int index = m_Lines.size();
+	const auto result = m_LineIndices.emplace(GetLineKey(vertex1, vertex2), index);
+	if (!result.second)
+	{
+		//Already added by the neighbouring triangle
+		m_LineTriangles[result.first->second][1] = triangleIndex;
+		return result.first->second;
+	}
+
+	m_Lines.emplace_back(m_MeshVertices[vertex1], m_MeshVertices[vertex2], index);
+	m_LineVertices.push_back({ { vertex1, vertex2 } });
+	m_LineTriangles.push_back({ { triangleIndex, -1 } });
+	return index;
+}
+#endif
+#ifdef USE_POINT_LOCATION_GRID
+void Elite::Polygon::BuildPointLocationGrid()
+{
+	m_GridCellStarts.clear();
+	m_GridTriangles.clear();
+	if (m_Triangles.empty())
+		return;
+
+	//Bounds of the triangulation
+	auto minPoint = Vector2((std::numeric_limits<float>::max)(), (std::numeric_limits<float>::max)());
+	auto maxPoint = Vector2(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+	for (const auto& p : m_MeshVertices)
+	{
+		minPoint.x = (std::min)(minPoint.x, p.x);
+		minPoint.y = (std::min)(minPoint.y, p.y);
+		maxPoint.x = (std::max)(maxPoint.x, p.x);
+		maxPoint.y = (std::max)(maxPoint.y, p.y);
+	}
+
+	//Around one triangle per cell
+	const auto size = maxPoint - minPoint;
+	const auto maxCellsPerAxis = 1024;
+	auto cellSize = sqrtf(size.x * size.y / static_cast<float>(m_Triangles.size()));
+	cellSize = (std::max)(cellSize, (std::max)(size.x, size.y) / static_cast<float>(maxCellsPerAxis));
+	cellSize = (std::max)(cellSize, FLT_EPSILON);
+	m_GridOrigin = minPoint;
+	m_GridInvCellSize = 1.f / cellSize;
+	m_GridColumns = (std::min)(static_cast<int>(size.x * m_GridInvCellSize) + 1, maxCellsPerAxis);
+	m_GridRows = (std::min)(static_cast<int>(size.y * m_GridInvCellSize) + 1, maxCellsPerAxis);
+
+	//Count the triangles per cell, sum to the cell ends and fill backwards so every count ends up as the cell start
+	m_GridCellStarts.assign(m_GridColumns * m_GridRows + 1, 0);
+	for (auto pass = 0; pass < 2; ++pass)
+	{
+		if (pass == 1)
 		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p2, t->p3, index));
-			t->metaData.IndexLines[1] = index;
+			for (size_t cell = 1; cell < m_GridCellStarts.size(); ++cell)
+				m_GridCellStarts[cell] += m_GridCellStarts[cell - 1];
+			m_GridTriangles.resize(m_GridCellStarts.back());
 		}
-		if (t->metaData.IndexLines[2] == -1)
+
+		for (auto i = 0; i < static_cast<int>(m_Triangles.size()); ++i)
 		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p3, t->p1, index));
-			t->metaData.IndexLines[2] = index;
+			const auto& t = m_Triangles[i];
+			int minColumn, minRow, maxColumn, maxRow;
+			GetGridCell(Vector2((std::min)({ t.p1.x, t.p2.x, t.p3.x }), (std::min)({ t.p1.y, t.p2.y, t.p3.y })), minColumn, minRow);
+			GetGridCell(Vector2((std::max)({ t.p1.x, t.p2.x, t.p3.x }), (std::max)({ t.p1.y, t.p2.y, t.p3.y })), maxColumn, maxRow);
+			for (auto row = (std::max)(minRow, 0); row <= (std::min)(maxRow, m_GridRows - 1); ++row)
+			{
+				for (auto column = (std::max)(minColumn, 0); column <= (std::min)(maxColumn, m_GridColumns - 1); ++column)
+				{
+					const auto cell = row * m_GridColumns + column;
+					if (pass == 0)
+						++m_GridCellStarts[cell];
+					else
+						m_GridTriangles[--m_GridCellStarts[cell]] = i;
+				}
+			}
 		}
 	}
-#endif
 }
+
+void Elite::Polygon::GetGridCell(const Vector2& position, int& column, int& row) const
+{
+	column = static_cast<int>(floorf((position.x - m_GridOrigin.x) * m_GridInvCellSize));
+	row = static_cast<int>(floorf((position.y - m_GridOrigin.y) * m_GridInvCellSize));
+}
+#endif
 #pragma endregion //PrivateGeneralFunctions
 //----------------------------------------------------------
 #pragma region PrivateTriangulationFunctions
@@ -644,6 +835,55 @@ void Elite::Polygon::Split()
 	m_vChildren.clear();
 	m_vChildren = newChildren;
 }
+#ifndef USE_SWEEP_TRIANGULATION
+int Elite::Polygon::AddMeshVertex(const Vector2& p)
+{
+	//The split polygon visits the bridge vertices twice, they share one mesh vertex
+	const auto it = std::find(m_MeshVertices.begin(), m_MeshVertices.end(), p);
+	if (it != m_MeshVertices.end())
+		return static_cast<int>(it - m_MeshVertices.begin());
+	m_MeshVertices.push_back(p);
+	return static_cast<int>(m_MeshVertices.size()) - 1;
+}
+#endif
+#ifdef USE_SWEEP_TRIANGULATION
+const std::vector<Elite::Triangle*>& Elite::Polygon::TriangulateSweep()
+{
+	//Outer shape and holes after each other in one vertex array, the triangulator fixes the winding
+	auto& vertices = m_MeshVertices;
+	vertices.clear();
+	std::vector<int> ringStarts{};
+	const auto addRing = [&vertices, &ringStarts](const std::list<Vector2>& points)
+	{
+		const int first{ static_cast<int>(vertices.size()) };
+		for (const auto& p : points)
+		{
+			if (static_cast<int>(vertices.size()) == first || vertices.back() != p)
+				vertices.push_back(p);
+		}
+		while (static_cast<int>(vertices.size()) > first + 1 && vertices.back() == vertices[first])
+			vertices.pop_back();
+
+		if (static_cast<int>(vertices.size()) - first < 3)
+			vertices.resize(first); //Not a shape
+		else
+			ringStarts.push_back(first);
+	};
+	addRing(m_vPoints);
+	if (!ringStarts.empty())
+	{
+		for (const auto& child : m_vChildren)
+			addRing(child.m_vPoints);
+	}
+
+	MonotoneTriangulator triangulator{};
+	triangulator.Triangulate(vertices, ringStarts, m_TriangleVertices);
+
+	BuildMesh();
+	return m_vpTriangles;
+}
+#endif
+
 #pragma endregion //PrivateTriangulationFunctions
 //----------------------------------------------------------
 #pragma endregion //Polygon
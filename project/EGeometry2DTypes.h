@@ -9,12 +9,15 @@
 
 #include "EGeometry2DUtilities.h"
 #include <array>
+#include <unordered_map>
 
 
 namespace Elite 
 {
 	//=== Options ===
 	#define USE_TRIANGLE_METADATA
+	#define USE_SWEEP_TRIANGULATION //Monotone sweep (O(n log n)) instead of ear clipping with Split()
+	#define USE_POINT_LOCATION_GRID //GetTriangleFromPosition only tests the triangles of one grid cell
 
 	//=== Types ===
 #pragma region Line
@@ -46,6 +49,7 @@ namespace Elite
 	struct TriangleMetaData final
 	{
 		std::array<int, 3> IndexLines{ {-1, -1, -1} };
+		int Index = -1; //Index in the triangle list of the polygon
 	};
 
 	struct Triangle final
@@ -87,7 +91,13 @@ namespace Elite
 		explicit Polygon(const std::vector<Vector2>& vertices);
 		explicit Polygon(const std::vector<Vector2>& outerShape, const std::vector<std::vector<Vector2>> &innerShapes);
 		explicit Polygon(const Vector2* vertices, int count);
-		~Polygon();
+		~Polygon() = default;
+
+		//The triangles and lines are pointed to by m_vpTriangles and m_vpLines, a copy points those at its own
+		Polygon(const Polygon& p);
+		Polygon& operator=(const Polygon& p);
+		Polygon(Polygon&& p) = default;
+		Polygon& operator=(Polygon&& p) = default;
 
 		//=== Functions ===
 		//Child functionality
@@ -105,6 +115,10 @@ namespace Elite
 		const std::vector<Polygon>& GetChildren() const;
 		const std::vector<Triangle*>& GetTriangles() const;
 		const std::vector<Line*>& GetLines() const;
+		//Flat triangulation, the triangles and lines refer to the mesh vertices by index
+		const std::vector<Vector2>& GetMeshVertices() const;
+		const std::vector<std::array<int, 3>>& GetTriangleVertices() const;
+		const std::vector<std::array<int, 2>>& GetLineVertices() const;
 
 		//Getters information
 		float GetPosVertMaxXPos() const;
@@ -117,8 +131,13 @@ namespace Elite
 		std::vector<Triangle*> GetAdjacentTrianglesOnLine(const Triangle* t, const Line& l) const;
 
 		const Triangle* GetTriangleFromPosition(const Vector2& position, bool onLineAllowed = false) const;
+		//Walks over the lines from pHint (e.g. the triangle of the last query), falls back to GetTriangleFromPosition
+		const Triangle* GetTriangleFromPositionNear(const Vector2& position, const Triangle* pHint, bool onLineAllowed = false) const;
 #ifdef USE_TRIANGLE_METADATA
 		const std::vector<const Triangle*> GetTrianglesFromLineIndex(unsigned int lineIndex) const;
+		//Indices of the (at most) two triangles on a line, -1 when the line is on the edge of the mesh
+		const std::array<int, 2>& GetLineTriangles(unsigned int lineIndex) const { return m_LineTriangles[lineIndex]; }
+		int GetLineIndex(const Line& l) const;
 #endif
 
 
@@ -136,20 +155,56 @@ namespace Elite
 		//=== Datamembers ===
 		std::vector<Polygon> m_vChildren; //Inner shapes of this polygon
 		std::list<Vector2> m_vPoints; //Points that define this polygon
-		std::vector<Triangle*> m_vpTriangles; //Triangles create for this polygon, used for rendering
-		std::vector<Line*> m_vpLines; //Lines constructing this polygon!
+		//Flat triangulation, stored contiguously and rebuilt as a whole by Triangulate
+		std::vector<Vector2> m_MeshVertices;
+		std::vector<std::array<int, 3>> m_TriangleVertices; //Vertex indices of every triangle
+		std::vector<Triangle> m_Triangles; //Triangles create for this polygon, used for rendering
+		std::vector<std::array<int, 2>> m_LineVertices; //Vertex indices of every line
+		std::vector<Line> m_Lines; //Lines constructing this polygon!
+		//Views on m_Triangles and m_Lines for the pointer accessors
+		std::vector<Triangle*> m_vpTriangles;
+		std::vector<Line*> m_vpLines;
 		bool m_isTriangulated = false;
+#ifdef USE_TRIANGLE_METADATA
+		std::unordered_map<unsigned long long, int> m_LineIndices; //Line per vertex pair, see GetLineKey
+		std::vector<std::array<int, 2>> m_LineTriangles; //Per line, see GetLineTriangles
+#endif
+#ifdef USE_POINT_LOCATION_GRID
+		//Uniform grid over the triangulation, every cell lists the triangles whose bounds overlap it
+		Vector2 m_GridOrigin = {};
+		float m_GridInvCellSize = 0.f;
+		int m_GridColumns = 0;
+		int m_GridRows = 0;
+		std::vector<int> m_GridCellStarts; //First entry of every cell in m_GridTriangles, one extra for the end
+		std::vector<int> m_GridTriangles;
+#endif
 
 		//=== Functions ===
 		//Private General Functions
 		void GetTriangle(const list<Vector2>& l, const list<Vector2>::const_iterator p, Vector2& currentTip, Vector2& previous, Vector2& next) const;
 		bool IsConvexInPolygon(const list<Vector2>& l, const list<Vector2>::const_iterator p) const;
 		bool IsEar(const list<Vector2>& l, const list<Vector2>::const_iterator p) const;
+		void BuildMesh();
+		void UpdateMeshViews();
 		void GenerateLineMatrix();
+#ifdef USE_TRIANGLE_METADATA
+		static unsigned long long GetLineKey(int vertex1, int vertex2);
+		int AddLine(int vertex1, int vertex2, int triangleIndex);
+#endif
+#ifdef USE_POINT_LOCATION_GRID
+		void BuildPointLocationGrid();
+		void GetGridCell(const Vector2& position, int& column, int& row) const;
+#endif
 
 		//Private Triangulation Functions
 		void FindMutualVisibleVertices(const Polygon& outer, const Polygon& inner, Vector2& pOuter, Vector2& pInner);
 		void Split();
+#ifndef USE_SWEEP_TRIANGULATION
+		int AddMeshVertex(const Vector2& p);
+#endif
+#ifdef USE_SWEEP_TRIANGULATION
+		const std::vector<Triangle*>& TriangulateSweep();
+#endif
 	};
 #pragma endregion //Polygon
 
@@ -106,7 +106,7 @@ namespace Elite
 		float posErrorMargin = 1.5f;
 		auto foundIt = find_if(m_Nodes.begin(), m_Nodes.end(),
 			[pos, posErrorMargin, this](T_NodeType* pNode)
-		{ return (pNode->GetPosition() - pos).MagnitudeSquared() < pow(posErrorMargin * GetNodeRadius(pNode), 2); });
+		{ return (pNode->GetPosition() - pos).SqrtMagnitude() < pow(posErrorMargin * GetNodeRadius(pNode), 2); });
 
 		if (foundIt != m_Nodes.end())
 			return (*foundIt)->GetIndex();
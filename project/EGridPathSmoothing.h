@@ -0,0 +1,127 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EGridPathSmoothing.h: Line of sight over the cells of a GridGraph and string pulling of grid paths.
+// Paths found over the grid are staircases, pulling the string keeps only the cells where the path turns.
+/*=============================================================================*/
+#pragma once
+
+#include <vector>
+#include "EGridGraph.h"
+
+namespace Elite
+{
+	class GridSmoothing final
+	{
+	public:
+		//=== Grid Smoothing Functions ===
+		//Cost to walk over a cell, -1 for cells that can't be entered (isolated or removed nodes)
+		template<class T_NodeType, class T_ConnectionType>
+		static int GetCellCost(const GridGraph<T_NodeType, T_ConnectionType>* pGrid, int idx)
+		{
+			const auto pNode = pGrid->GetNode(idx);
+			if (pNode->GetIndex() == invalid_node_index || pGrid->GetNodeConnections(idx).empty())
+				return -1;
+			return 1;
+		}
+
+		template<class T_ConnectionType>
+		static int GetCellCost(const GridGraph<GridTerrainNode, T_ConnectionType>* pGrid, int idx)
+		{
+			const auto pNode = pGrid->GetNode(idx);
+			if (pNode->GetIndex() == invalid_node_index || pGrid->GetNodeConnections(idx).empty())
+				return -1;
+			return int(pNode->GetTerrainType());
+		}
+
+		//True when the straight line between the cell centers only crosses cells that are no more expensive than
+		//the costlier end cell, so a shortcut never runs through mud the grid path went around.
+		//Every cell the line touches is visited (supercover). A line through a corner needs one of the two cells next to it,
+		//the same corners the diagonal connections of the grid cut.
+		template<class T_NodeType, class T_ConnectionType>
+		static bool HasLineOfSight(const GridGraph<T_NodeType, T_ConnectionType>* pGrid, int fromIdx, int toIdx)
+		{
+			const auto fromCost = GetCellCost(pGrid, fromIdx);
+			const auto toCost = GetCellCost(pGrid, toIdx);
+			if (fromCost == -1 || toCost == -1)
+				return false;
+			const auto maxCost = (std::max)(fromCost, toCost);
+			const auto isPassable = [pGrid, maxCost](int col, int row)
+			{
+				const auto cost = GetCellCost(pGrid, pGrid->GetIndex(col, row));
+				return cost != -1 && cost <= maxCost;
+			};
+
+			const auto columns = pGrid->GetColumns();
+			auto col = fromIdx % columns;
+			auto row = fromIdx / columns;
+			const auto toCol = toIdx % columns;
+			const auto toRow = toIdx / columns;
+			const auto stepsX = abs(toCol - col);
+			const auto stepsY = abs(toRow - row);
+			const auto signX = toCol > col ? 1 : -1;
+			const auto signY = toRow > row ? 1 : -1;
+
+			//Integer walk over the cell borders, the decision compares where the line crosses the next vertical and horizontal border
+			for (auto x = 0, y = 0; x < stepsX || y < stepsY;)
+			{
+				const auto decision = (1 + 2 * x) * stepsY - (1 + 2 * y) * stepsX;
+				if (decision == 0)
+				{
+					//Through a corner
+					if (!isPassable(col + signX, row) && !isPassable(col, row + signY))
+						return false;
+					col += signX;
+					row += signY;
+					++x;
+					++y;
+				}
+				else if (decision < 0)
+				{
+					col += signX;
+					++x;
+				}
+				else
+				{
+					row += signY;
+					++y;
+				}
+
+				if (!isPassable(col, row))
+					return false;
+			}
+			return true;
+		}
+
+		//Keeps the first and last node and every node the previous kept node can't see past, written into smoothedPath
+		template<class T_NodeType, class T_ConnectionType>
+		static void SmoothPath(const GridGraph<T_NodeType, T_ConnectionType>* pGrid, const std::vector<T_NodeType*>& path,
+			std::vector<T_NodeType*>& smoothedPath)
+		{
+			smoothedPath.clear();
+			if (path.empty())
+				return;
+
+			smoothedPath.push_back(path.front());
+			for (size_t i = 1; i + 1 < path.size(); ++i)
+			{
+				if (!HasLineOfSight(pGrid, smoothedPath.back()->GetIndex(), path[i + 1]->GetIndex()))
+					smoothedPath.push_back(path[i]);
+			}
+			if (path.size() > 1)
+				smoothedPath.push_back(path.back());
+		}
+
+		template<class T_NodeType, class T_ConnectionType>
+		static std::vector<T_NodeType*> SmoothPath(const GridGraph<T_NodeType, T_ConnectionType>* pGrid, const std::vector<T_NodeType*>& path)
+		{
+			std::vector<T_NodeType*> vSmoothedPath = {};
+			SmoothPath(pGrid, path, vSmoothedPath);
+			return vSmoothedPath;
+		}
+
+	private:
+		GridSmoothing() {};
+		~GridSmoothing() {};
+	};
+}
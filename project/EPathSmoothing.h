@@ -1,8 +1,9 @@
 #pragma once
 
 #include <vector>
-#include "framework/EliteGeometry/EGeometry2DTypes.h"
-#include "framework/EliteAI/EliteGraphs/EGraphNodeTypes.h"
+#include <limits>
+#include "EGeometry2DTypes.h"
+#include "EGraphNodeTypes.h"
 
 namespace Elite
 {
@@ -24,14 +25,19 @@ namespace Elite
 		//--- References ---
 		//http://digestingduck.blogspot.be/2010/03/simple-stupid-funnel-algorithm.html
 		//https://gamedev.stackexchange.com/questions/68302/how-does-the-simple-stupid-funnel-algorithm-work
-		static std::vector<Portal> FindPortals(
+		//Portals of the lines on the path, written into portals (its capacity is reused). P1 is the right point.
+		//Every portal is shrunk by agentRadius on both ends, so the path keeps that distance to the portal corners
+		static void FindPortals(
 			const std::vector<NavGraphNode*>& nodePath,
-			Polygon* navMeshPolygon)
+			const Polygon* navMeshPolygon,
+			std::vector<Portal>& portals,
+			float agentRadius = 0.f)
 		{
-			//Container
-			std::vector<Portal> vPortals = {};
+			portals.clear();
+			if (nodePath.empty())
+				return;
 
-			vPortals.push_back(Portal(Line(nodePath[0]->GetPosition(), nodePath[0]->GetPosition())));
+			portals.push_back(Portal(Line(nodePath[0]->GetPosition(), nodePath[0]->GetPosition())));
 
 			//For each node received, get it's corresponding line
 			for (size_t i = 1; i < nodePath.size() - 1; ++i)
@@ -42,7 +48,7 @@ namespace Elite
 
 				//Redetermine it's "orientation" based on the required path (left-right vs right-left) - p1 should be right point
 				auto centerLine = (pLine->p1 + pLine->p2) / 2.0f;
-				auto previousPosition = i == 0 ? nodePath[0]->GetPosition() : nodePath[i - 1]->GetPosition();
+				auto previousPosition = nodePath[i - 1]->GetPosition();
 				auto cp = Cross((centerLine - previousPosition), (pLine->p1 - previousPosition));
 				Line portalLine = {};
 				if (cp > 0)//Left
@@ -50,19 +56,57 @@ namespace Elite
 				else //Right
 					portalLine = Line(pLine->p1, pLine->p2);
 
+				//Offset the end points inwards, a portal narrower than the agent collapses to its center
+				if (agentRadius > 0.f)
+				{
+					auto direction = portalLine.p2 - portalLine.p1;
+					const auto length = direction.Magnitude();
+					if (length <= 2.f * agentRadius)
+					{
+						portalLine = Line(centerLine, centerLine);
+					}
+					else
+					{
+						direction *= agentRadius / length;
+						portalLine.p1 += direction;
+						portalLine.p2 -= direction;
+					}
+				}
+
 				//Store portal
-				vPortals.push_back(Portal(portalLine));
+				portals.push_back(Portal(portalLine));
 			}
 			//Add degenerate portal to force end evaluation
-			vPortals.push_back(Portal(Line(nodePath[nodePath.size()-1]->GetPosition(), nodePath[nodePath.size() - 1]->GetPosition())));
+			portals.push_back(Portal(Line(nodePath[nodePath.size()-1]->GetPosition(), nodePath[nodePath.size() - 1]->GetPosition())));
+		}
 
+		static std::vector<Portal> FindPortals(
+			const std::vector<NavGraphNode*>& nodePath,
+			Polygon* navMeshPolygon)
+		{
+			std::vector<Portal> vPortals = {};
+			FindPortals(nodePath, navMeshPolygon, vPortals);
 			return vPortals;
 		}
 
-		static std::vector<Elite::Vector2> OptimizePortals(const std::vector<Portal>& portals)
+		//Writes the corners after the start into path (its capacity is reused), ending at the goal.
+		//Stops after maxCorners points, so a caller that only steers to the next few corners doesn't pull the whole string.
+		//Returns true when the goal was reached, false when maxCorners cut the path short.
+		static bool OptimizePortals(const std::vector<Portal>& portals, std::vector<Elite::Vector2>& vPath,
+			size_t maxCorners = (std::numeric_limits<size_t>::max)())
 		{
+			vPath.clear();
+			if (portals.empty())
+				return true;
+			if (maxCorners == 0)
+				return false;
+			if (portals.size() == 1)
+			{
+				vPath.push_back(portals[0].Line.p1);
+				return true;
+			}
+
 			//P1 == right point of portal, P2 == left point of portal
-			std::vector<Elite::Vector2> vPath = {};
 			auto apex = portals[0].Line.p1;
 			auto apexIndex = 0, leftLegIndex = 1, rightLegIndex = 1;
 			auto rightLeg = portals[rightLegIndex].Line.p1 - apex;
@@ -81,7 +125,7 @@ namespace Elite
 				{
 					//2. See if new line degenerates a line segment - RIGHT
 					crossArea = Cross(rToNextPortal, leftLeg);
-					if (crossArea > 0)
+					if (rightLeg == Elite::ZeroVector2 || crossArea > 0) //Leg collapsed on the apex after a restart, always tighten
 					{
 
 						rightLeg = rToNextPortal;
@@ -89,16 +133,23 @@ namespace Elite
 					}
 					else 
 					{
+						//Right crosses over left, left point becomes the new apex
 						apex += leftLeg;
 						apexIndex = leftLegIndex;
+						if (vPath.empty() || vPath.back() != apex) //Consecutive portals can share the apex point
+							vPath.push_back(apex);
+						if (vPath.size() >= maxCorners)
+							return false;
+						//Restart the funnel from the portal after the apex
 						int nextPortalIt = apexIndex + 1;
-						i, leftLegIndex, rightLegIndex = nextPortalIt;
-						vPath.push_back(apex);
+						i = apexIndex;
+						leftLegIndex = rightLegIndex = nextPortalIt;
 						if (nextPortalIt < static_cast<int>(portals.size()))
 						{
-							rightLeg = portals[i].Line.p1 - apex;
-							leftLeg = portals[i].Line.p2 - apex;
+							rightLeg = portals[nextPortalIt].Line.p1 - apex;
+							leftLeg = portals[nextPortalIt].Line.p2 - apex;
 						}
+						continue;
 					}
 				}
 
@@ -110,30 +161,45 @@ namespace Elite
 				{
 					//2. See if new line degenerates a line segment - LEFT
 					crossArea = Cross(lToNextPortal, rightLeg);
-					if (crossArea < 0)
+					if (leftLeg == Elite::ZeroVector2 || crossArea < 0) //Leg collapsed on the apex after a restart, always tighten
 					{
 						leftLeg = lToNextPortal;
 						leftLegIndex = i;
 					}
 					else
 					{
+						//Left crosses over right, right point becomes the new apex
 						apex += rightLeg;
 						apexIndex = rightLegIndex;
+						if (vPath.empty() || vPath.back() != apex) //Consecutive portals can share the apex point
+							vPath.push_back(apex);
+						if (vPath.size() >= maxCorners)
+							return false;
+						//Restart the funnel from the portal after the apex
 						int nextPortalIt = apexIndex + 1;
-						i, leftLegIndex, rightLegIndex = nextPortalIt;
-						vPath.push_back(apex);
+						i = apexIndex;
+						leftLegIndex = rightLegIndex = nextPortalIt;
 						if (nextPortalIt < static_cast<int>(portals.size()))
 						{
-							rightLeg = portals[i].Line.p1 - apex;
-							leftLeg = portals[i].Line.p2 - apex;
+							rightLeg = portals[nextPortalIt].Line.p1 - apex;
+							leftLeg = portals[nextPortalIt].Line.p2 - apex;
 						}
+						continue;
 					}
 			
 				}
 
 			}
 			// Add last path point (You can use the last portal p1 or p2 points as both are equal to the endPoint of the path
-			vPath.push_back(portals.back().Line.p1);
+			if (vPath.empty() || vPath.back() != portals.back().Line.p1)
+				vPath.push_back(portals.back().Line.p1);
+			return true;
+		}
+
+		static std::vector<Elite::Vector2> OptimizePortals(const std::vector<Portal>& portals)
+		{
+			std::vector<Elite::Vector2> vPath = {};
+			OptimizePortals(portals, vPath);
 			return vPath;
 		}
 	private:
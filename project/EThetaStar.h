@@ -0,0 +1,198 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EThetaStar.h: Any-angle search over a GridGraph (Theta*, Nash et al. 2007). Like A*, but a node can take the
+// parent of its parent when that one is in line of sight, so the path is made of straight lines between corners.
+// The lazy variant (Lazy Theta*, Nash et al. 2010) assumes line of sight and only checks it when a node is expanded.
+/*=============================================================================*/
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "EGridPathSmoothing.h"
+#include "ENavigation.h"
+
+namespace Elite
+{
+	template <class T_NodeType, class T_ConnectionType>
+	class ThetaStar
+	{
+	public:
+		ThetaStar(GridGraph<T_NodeType, T_ConnectionType>* pGrid, Heuristic hFunction, bool isLazy = true);
+
+		//Corners of the path from start to goal, empty when the goal can't be reached
+		std::vector<T_NodeType*> FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode);
+		//Same, written into path. The search buffers are kept between calls
+		bool FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode, std::vector<T_NodeType*>& path);
+
+		void SetLazy(bool isLazy) { m_IsLazy = isLazy; }
+		bool IsLazy() const { return m_IsLazy; }
+
+	private:
+		using OpenRecord = std::pair<float, int>; //Estimated total cost, node index
+
+		GridGraph<T_NodeType, T_ConnectionType>* m_pGrid;
+		Heuristic m_HeuristicFunction;
+		bool m_IsLazy;
+
+		//Per node, only valid when its search id is the current one, so nothing is cleared between searches
+		std::vector<unsigned int> m_SearchIds{};
+		std::vector<float> m_CostSoFar{};
+		std::vector<int> m_Parents{};
+		std::vector<bool> m_IsClosed{};
+		std::vector<OpenRecord> m_OpenHeap{};
+		unsigned int m_SearchId = 0;
+
+		void VisitNode(int idx);
+		bool IsClosed(int idx) const { return m_SearchIds[idx] == m_SearchId && m_IsClosed[idx]; }
+		void SetVertex(int idx);
+		float GetCost(int fromIdx, int toIdx) const;
+		float GetHeuristicCost(int fromIdx, int toIdx) const;
+	};
+
+	template <class T_NodeType, class T_ConnectionType>
+	ThetaStar<T_NodeType, T_ConnectionType>::ThetaStar(GridGraph<T_NodeType, T_ConnectionType>* pGrid, Heuristic hFunction, bool isLazy)
+		: m_pGrid(pGrid)
+		, m_HeuristicFunction(hFunction)
+		, m_IsLazy(isLazy)
+	{
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	std::vector<T_NodeType*> ThetaStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode)
+	{
+		std::vector<T_NodeType*> path{};
+		FindPath(pStartNode, pGoalNode, path);
+		return path;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	bool ThetaStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode, std::vector<T_NodeType*>& path)
+	{
+		path.clear();
+		const auto nrOfNodes = static_cast<size_t>(m_pGrid->GetNrOfNodes());
+		if (m_SearchIds.size() != nrOfNodes)
+		{
+			m_SearchIds.assign(nrOfNodes, 0);
+			m_CostSoFar.resize(nrOfNodes);
+			m_Parents.resize(nrOfNodes);
+			m_IsClosed.resize(nrOfNodes);
+			m_SearchId = 0;
+		}
+		if (++m_SearchId == 0) //Wrapped around, old ids could match again
+		{
+			std::fill(m_SearchIds.begin(), m_SearchIds.end(), 0);
+			m_SearchId = 1;
+		}
+
+		const auto startIdx = pStartNode->GetIndex();
+		const auto goalIdx = pGoalNode->GetIndex();
+		VisitNode(startIdx);
+		m_CostSoFar[startIdx] = 0.f;
+		m_Parents[startIdx] = startIdx;
+
+		const auto compare = std::greater<OpenRecord>{};
+		m_OpenHeap.clear();
+		m_OpenHeap.push_back({ GetHeuristicCost(startIdx, goalIdx), startIdx });
+		while (!m_OpenHeap.empty())
+		{
+			std::pop_heap(m_OpenHeap.begin(), m_OpenHeap.end(), compare);
+			const auto currentIdx = m_OpenHeap.back().second;
+			m_OpenHeap.pop_back();
+			//A node is pushed again for every cheaper cost, the cheapest comes out first
+			if (IsClosed(currentIdx))
+				continue;
+
+			if (m_IsLazy)
+				SetVertex(currentIdx);
+			m_IsClosed[currentIdx] = true;
+			if (currentIdx == goalIdx)
+				break;
+
+			for (const auto pConnection : m_pGrid->GetNodeConnections(currentIdx))
+			{
+				const auto neighborIdx = pConnection->GetTo();
+				if (IsClosed(neighborIdx))
+					continue;
+				VisitNode(neighborIdx);
+
+				//Path 2 goes straight from the parent, the lazy variant checks the line of sight once the neighbor is expanded
+				auto parentIdx = m_Parents[currentIdx];
+				if (!m_IsLazy && !GridSmoothing::HasLineOfSight(m_pGrid, parentIdx, neighborIdx))
+					parentIdx = currentIdx;
+
+				const auto costSoFar = m_CostSoFar[parentIdx] + GetCost(parentIdx, neighborIdx);
+				if (costSoFar < m_CostSoFar[neighborIdx])
+				{
+					m_CostSoFar[neighborIdx] = costSoFar;
+					m_Parents[neighborIdx] = parentIdx;
+					m_OpenHeap.push_back({ costSoFar + GetHeuristicCost(neighborIdx, goalIdx), neighborIdx });
+					std::push_heap(m_OpenHeap.begin(), m_OpenHeap.end(), compare);
+				}
+			}
+		}
+
+		if (!IsClosed(goalIdx))
+			return false;
+
+		for (auto idx = goalIdx; idx != startIdx; idx = m_Parents[idx])
+			path.push_back(m_pGrid->GetNode(idx));
+		path.push_back(pStartNode);
+		std::reverse(path.begin(), path.end());
+		return true;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	void ThetaStar<T_NodeType, T_ConnectionType>::VisitNode(int idx)
+	{
+		if (m_SearchIds[idx] == m_SearchId)
+			return;
+		m_SearchIds[idx] = m_SearchId;
+		m_CostSoFar[idx] = (std::numeric_limits<float>::max)();
+		m_Parents[idx] = invalid_node_index;
+		m_IsClosed[idx] = false;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	void ThetaStar<T_NodeType, T_ConnectionType>::SetVertex(int idx)
+	{
+		//The parent was assumed to be visible, otherwise take the best expanded neighbor as parent
+		const auto parentIdx = m_Parents[idx];
+		if (parentIdx == idx || GridSmoothing::HasLineOfSight(m_pGrid, parentIdx, idx))
+			return;
+
+		auto bestCost = (std::numeric_limits<float>::max)();
+		for (const auto pConnection : m_pGrid->GetNodeConnections(idx))
+		{
+			const auto neighborIdx = pConnection->GetTo();
+			if (!IsClosed(neighborIdx))
+				continue;
+			const auto cost = m_CostSoFar[neighborIdx] + GetCost(neighborIdx, idx);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				m_Parents[idx] = neighborIdx;
+			}
+		}
+		if (bestCost != (std::numeric_limits<float>::max)())
+			m_CostSoFar[idx] = bestCost;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	float ThetaStar<T_NodeType, T_ConnectionType>::GetCost(int fromIdx, int toIdx) const
+	{
+		//Straight line in cells, weighted by the costlier end cell (line of sight never crosses anything costlier)
+		const auto columns = m_pGrid->GetColumns();
+		const Vector2 toDestination{ float(toIdx % columns - fromIdx % columns), float(toIdx / columns - fromIdx / columns) };
+		const auto cellCost = (std::max)(GridSmoothing::GetCellCost(m_pGrid, fromIdx), GridSmoothing::GetCellCost(m_pGrid, toIdx));
+		return toDestination.Magnitude() * static_cast<float>((std::max)(cellCost, 1));
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	float ThetaStar<T_NodeType, T_ConnectionType>::GetHeuristicCost(int fromIdx, int toIdx) const
+	{
+		const auto columns = m_pGrid->GetColumns();
+		return m_HeuristicFunction(float(abs(toIdx % columns - fromIdx % columns)), float(abs(toIdx / columns - fromIdx / columns)));
+	}
+}
@@ -0,0 +1,336 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// ETriangulation.cpp: Implementation of the sweep line triangulation.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "ETriangulation.h"
+
+void Elite::MonotoneTriangulator::Triangulate(const std::vector<Vector2>& vertices, const std::vector<int>& ringStarts, std::vector<std::array<int, 3>>& triangles)
+{
+	triangles.clear();
+	m_pVertices = &vertices;
+	const int count{ static_cast<int>(vertices.size()) };
+	if (count < 3 || ringStarts.empty())
+		return;
+
+	//Link the rings, outer shape CCW and holes CW so the inside is always left of an edge
+	m_Prev.resize(count);
+	m_Next.resize(count);
+	for (size_t ring{}; ring < ringStarts.size(); ++ring)
+	{
+		const int first{ ringStarts[ring] };
+		const int last{ ring + 1 < ringStarts.size() ? ringStarts[ring + 1] - 1 : count - 1 };
+		float signedArea{};
+		for (int i{ first }; i <= last; ++i)
+			signedArea += Cross(vertices[i], vertices[i == last ? first : i + 1]);
+
+		const bool isReversed{ (ring == 0) == (signedArea < 0.f) };
+		for (int i{ first }; i <= last; ++i)
+		{
+			const int prev{ i == first ? last : i - 1 };
+			const int next{ i == last ? first : i + 1 };
+			m_Prev[i] = isReversed ? next : prev;
+			m_Next[i] = isReversed ? prev : next;
+		}
+	}
+
+	m_Types.resize(count);
+	for (int vertex{}; vertex < count; ++vertex)
+		Classify(vertex);
+
+	m_Order.resize(count);
+	for (int vertex{}; vertex < count; ++vertex)
+		m_Order[vertex] = vertex;
+	std::sort(m_Order.begin(), m_Order.end(), [this](int a, int b) { return IsAbove(a, b); });
+
+	//Sweep from top to bottom, adding the diagonals that split the polygon into monotone pieces
+	m_Status.clear();
+	m_StatusIterators.assign(count, m_Status.end());
+	m_Helpers.assign(count, -1);
+	m_Diagonals.clear();
+	for (const int vertex : m_Order)
+		SweepVertex(vertex);
+
+	//Walk every monotone piece and triangulate it
+	BuildHalfEdges();
+	m_IsHalfEdgeUsed.assign(m_HalfEdgeTargets.size(), false);
+	m_IsOnLeftChain.assign(count, false);
+	for (int vertex{}; vertex < count; ++vertex)
+	{
+		for (int halfEdge{ m_HalfEdgeStarts[vertex] }; halfEdge < m_HalfEdgeStarts[vertex + 1]; ++halfEdge)
+		{
+			if (m_IsHalfEdgeUsed[halfEdge])
+				continue;
+
+			m_Face.clear();
+			int from{ vertex };
+			int current{ halfEdge };
+			while (!m_IsHalfEdgeUsed[current])
+			{
+				m_IsHalfEdgeUsed[current] = true;
+				m_Face.push_back(from);
+				const int at{ m_HalfEdgeTargets[current] };
+				current = GetNextHalfEdge(from, at);
+				from = at;
+			}
+			TriangulateMonotone(triangles);
+		}
+	}
+}
+
+#pragma region Sweep
+//Top to bottom, left to right on equal height
+bool Elite::MonotoneTriangulator::IsAbove(int a, int b) const
+{
+	const Vector2& pA{ (*m_pVertices)[a] };
+	const Vector2& pB{ (*m_pVertices)[b] };
+	return pA.y > pB.y || (pA.y == pB.y && pA.x < pB.x);
+}
+
+float Elite::MonotoneTriangulator::GetSweepX(int key) const
+{
+	if (key < 0)
+		return (*m_pVertices)[-key - 1].x;
+
+	const Vector2& p1{ (*m_pVertices)[key] };
+	const Vector2& p2{ (*m_pVertices)[m_Next[key]] };
+	//A horizontal edge only lives in the status between its two vertices, at its left vertex
+	if (p1.y == p2.y)
+		return (std::min)(p1.x, p2.x);
+	return p1.x + (m_SweepY - p1.y) * (p2.x - p1.x) / (p2.y - p1.y);
+}
+
+void Elite::MonotoneTriangulator::Classify(int vertex)
+{
+	const Vector2& prev{ (*m_pVertices)[m_Prev[vertex]] };
+	const Vector2& current{ (*m_pVertices)[vertex] };
+	const Vector2& next{ (*m_pVertices)[m_Next[vertex]] };
+	const bool isPrevAbove{ IsAbove(m_Prev[vertex], vertex) };
+	const bool isNextAbove{ IsAbove(m_Next[vertex], vertex) };
+	const bool isConvex{ Cross(current - prev, next - current) > 0.f };
+
+	if (!isPrevAbove && !isNextAbove)
+		m_Types[vertex] = isConvex ? VertexType::Start : VertexType::Split;
+	else if (isPrevAbove && isNextAbove)
+		m_Types[vertex] = isConvex ? VertexType::End : VertexType::Merge;
+	else
+		m_Types[vertex] = VertexType::Regular;
+}
+
+void Elite::MonotoneTriangulator::InsertEdge(int edge, int helper)
+{
+	m_StatusIterators[edge] = m_Status.insert(edge).first;
+	m_Helpers[edge] = helper;
+}
+
+void Elite::MonotoneTriangulator::RemoveEdge(int edge)
+{
+	if (m_StatusIterators[edge] == m_Status.end())
+		return;
+	m_Status.erase(m_StatusIterators[edge]);
+	m_StatusIterators[edge] = m_Status.end();
+}
+
+//Edge in the status directly left of the vertex, -1 when there is none (invalid input)
+int Elite::MonotoneTriangulator::GetLeftEdge(int vertex)
+{
+	const auto it{ m_Status.lower_bound(-vertex - 1) };
+	if (it == m_Status.begin())
+		return -1;
+	return *std::prev(it);
+}
+
+void Elite::MonotoneTriangulator::ConnectToHelper(int vertex, int edge)
+{
+	if (edge < 0 || m_Helpers[edge] < 0)
+		return;
+	if (m_Types[m_Helpers[edge]] == VertexType::Merge)
+		m_Diagonals.emplace_back(vertex, m_Helpers[edge]);
+}
+
+void Elite::MonotoneTriangulator::SweepVertex(int vertex)
+{
+	m_SweepY = (*m_pVertices)[vertex].y;
+	const int prevEdge{ m_Prev[vertex] };
+
+	switch (m_Types[vertex])
+	{
+	case VertexType::Start:
+		InsertEdge(vertex, vertex);
+		break;
+	case VertexType::End:
+		ConnectToHelper(vertex, prevEdge);
+		RemoveEdge(prevEdge);
+		break;
+	case VertexType::Split:
+	{
+		const int leftEdge{ GetLeftEdge(vertex) };
+		if (leftEdge >= 0)
+		{
+			m_Diagonals.emplace_back(vertex, m_Helpers[leftEdge]);
+			m_Helpers[leftEdge] = vertex;
+		}
+		InsertEdge(vertex, vertex);
+		break;
+	}
+	case VertexType::Merge:
+	{
+		ConnectToHelper(vertex, prevEdge);
+		RemoveEdge(prevEdge);
+		const int leftEdge{ GetLeftEdge(vertex) };
+		ConnectToHelper(vertex, leftEdge);
+		if (leftEdge >= 0)
+			m_Helpers[leftEdge] = vertex;
+		break;
+	}
+	case VertexType::Regular:
+		if (IsAbove(m_Prev[vertex], vertex))
+		{
+			//Left side of the polygon, the inside is to the right
+			ConnectToHelper(vertex, prevEdge);
+			RemoveEdge(prevEdge);
+			InsertEdge(vertex, vertex);
+		}
+		else
+		{
+			const int leftEdge{ GetLeftEdge(vertex) };
+			ConnectToHelper(vertex, leftEdge);
+			if (leftEdge >= 0)
+				m_Helpers[leftEdge] = vertex;
+		}
+		break;
+	}
+}
+#pragma endregion //Sweep
+
+#pragma region MonotonePieces
+void Elite::MonotoneTriangulator::BuildHalfEdges()
+{
+	const int count{ static_cast<int>(m_pVertices->size()) };
+
+	//Boundary edge first, then the diagonals in both directions
+	m_HalfEdgeStarts.assign(count + 1, 0);
+	for (int vertex{}; vertex < count; ++vertex)
+		++m_HalfEdgeStarts[vertex + 1];
+	for (const std::pair<int, int>& diagonal : m_Diagonals)
+	{
+		++m_HalfEdgeStarts[diagonal.first + 1];
+		++m_HalfEdgeStarts[diagonal.second + 1];
+	}
+	for (int vertex{}; vertex < count; ++vertex)
+		m_HalfEdgeStarts[vertex + 1] += m_HalfEdgeStarts[vertex];
+
+	m_HalfEdgeTargets.resize(m_HalfEdgeStarts[count]);
+	//Helpers are done, reuse them as the fill position of every vertex
+	for (int vertex{}; vertex < count; ++vertex)
+	{
+		m_HalfEdgeTargets[m_HalfEdgeStarts[vertex]] = m_Next[vertex];
+		m_Helpers[vertex] = m_HalfEdgeStarts[vertex] + 1;
+	}
+	for (const std::pair<int, int>& diagonal : m_Diagonals)
+	{
+		m_HalfEdgeTargets[m_Helpers[diagonal.first]++] = diagonal.second;
+		m_HalfEdgeTargets[m_Helpers[diagonal.second]++] = diagonal.first;
+	}
+}
+
+//Keeps the piece on the left: the first half-edge clockwise from the way back
+int Elite::MonotoneTriangulator::GetNextHalfEdge(int from, int at) const
+{
+	const Vector2 toFrom{ (*m_pVertices)[from] - (*m_pVertices)[at] };
+	int bestHalfEdge{ m_HalfEdgeStarts[at] };
+	float bestAngle{ FLT_MAX };
+	for (int halfEdge{ m_HalfEdgeStarts[at] }; halfEdge < m_HalfEdgeStarts[at + 1]; ++halfEdge)
+	{
+		const Vector2 toTarget{ (*m_pVertices)[m_HalfEdgeTargets[halfEdge]] - (*m_pVertices)[at] };
+		float angle{ atan2f(Cross(toTarget, toFrom), Dot(toTarget, toFrom)) };
+		if (angle <= 0.f)
+			angle += static_cast<float>(2.0 * M_PI);
+		if (angle < bestAngle)
+		{
+			bestAngle = angle;
+			bestHalfEdge = halfEdge;
+		}
+	}
+	return bestHalfEdge;
+}
+
+void Elite::MonotoneTriangulator::TriangulateMonotone(std::vector<std::array<int, 3>>& triangles)
+{
+	const int size{ static_cast<int>(m_Face.size()) };
+	if (size < 3)
+		return;
+	if (size == 3)
+	{
+		AddTriangle(m_Face[0], m_Face[1], m_Face[2], triangles);
+		return;
+	}
+
+	//Going CCW, the left chain runs from the top down to the bottom
+	int top{};
+	int bottom{};
+	for (int i{ 1 }; i < size; ++i)
+	{
+		if (IsAbove(m_Face[i], m_Face[top]))
+			top = i;
+		if (IsAbove(m_Face[bottom], m_Face[i]))
+			bottom = i;
+	}
+	for (int i{ top }; i != bottom; i = (i + 1) % size)
+		m_IsOnLeftChain[m_Face[i]] = true;
+	for (int i{ bottom }; i != top; i = (i + 1) % size)
+		m_IsOnLeftChain[m_Face[i]] = false;
+
+	std::sort(m_Face.begin(), m_Face.end(), [this](int a, int b) { return IsAbove(a, b); });
+
+	m_Stack.clear();
+	m_Stack.push_back(m_Face[0]);
+	m_Stack.push_back(m_Face[1]);
+	for (int j{ 2 }; j < size - 1; ++j)
+	{
+		const int vertex{ m_Face[j] };
+		if (m_IsOnLeftChain[vertex] != m_IsOnLeftChain[m_Stack.back()])
+		{
+			//Other chain: every vertex on the stack is visible
+			for (size_t k{ 1 }; k < m_Stack.size(); ++k)
+				AddTriangle(vertex, m_Stack[k - 1], m_Stack[k], triangles);
+			const int previous{ m_Stack.back() };
+			m_Stack.clear();
+			m_Stack.push_back(previous);
+		}
+		else
+		{
+			//Same chain: cut off triangles while the vertex on the chain is convex
+			int last{ m_Stack.back() };
+			m_Stack.pop_back();
+			while (!m_Stack.empty())
+			{
+				const int other{ m_Stack.back() };
+				const Vector2& pVertex{ (*m_pVertices)[vertex] };
+				const Vector2& pLast{ (*m_pVertices)[last] };
+				const Vector2& pOther{ (*m_pVertices)[other] };
+				const float turn{ m_IsOnLeftChain[vertex] ? Cross(pLast - pOther, pVertex - pLast) : Cross(pLast - pVertex, pOther - pLast) };
+				if (turn <= 0.f)
+					break;
+				AddTriangle(vertex, last, other, triangles);
+				last = other;
+				m_Stack.pop_back();
+			}
+			m_Stack.push_back(last);
+		}
+		m_Stack.push_back(vertex);
+	}
+
+	const int lowest{ m_Face[size - 1] };
+	for (size_t k{ 1 }; k < m_Stack.size(); ++k)
+		AddTriangle(lowest, m_Stack[k - 1], m_Stack[k], triangles);
+}
+
+void Elite::MonotoneTriangulator::AddTriangle(int a, int b, int c, std::vector<std::array<int, 3>>& triangles) const
+{
+	if (Cross((*m_pVertices)[b] - (*m_pVertices)[a], (*m_pVertices)[c] - (*m_pVertices)[a]) < 0.f)
+		std::swap(b, c);
+	triangles.push_back({ a, b, c });
+}
+#pragma endregion //MonotonePieces
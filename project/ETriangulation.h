@@ -0,0 +1,89 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// ETriangulation.h: Sweep line triangulation of a polygon with holes in O(n log n).
+// The polygon is split into y-monotone pieces by a sweep from top to bottom, every piece is
+// then triangulated in linear time with a stack (de Berg et al., Computational Geometry, ch. 3).
+/*=============================================================================*/
+#ifndef ELITE_TRIANGULATION
+#define ELITE_TRIANGULATION
+
+//-----------------------------------------------------------------
+// Includes & Forward Declarations
+//-----------------------------------------------------------------
+#include "EGeometry2DUtilities.h"
+#include <array>
+#include <set>
+
+namespace Elite
+{
+	class MonotoneTriangulator final
+	{
+	public:
+		MonotoneTriangulator() = default;
+		~MonotoneTriangulator() = default;
+
+		MonotoneTriangulator(const MonotoneTriangulator&) = delete; //Status compare points back at this
+		MonotoneTriangulator& operator=(const MonotoneTriangulator&) = delete;
+
+		//Rings are stored after each other in vertices, ringStarts holds the first vertex of every ring.
+		//The first ring is the outer shape, the others are holes, any winding. Holes can't touch each other or the outer shape.
+		//Output are CCW index triples into vertices, the buffers of this object are reused between calls.
+		void Triangulate(const std::vector<Vector2>& vertices, const std::vector<int>& ringStarts, std::vector<std::array<int, 3>>& triangles);
+
+	private:
+		enum class VertexType : unsigned char
+		{
+			Start,
+			End,
+			Split,
+			Merge,
+			Regular
+		};
+
+		//Orders the edges crossed by the sweep line from left to right, negative keys are vertex probes (-vertex - 1)
+		struct StatusCompare final
+		{
+			const MonotoneTriangulator* pTriangulator = nullptr;
+			bool operator()(int a, int b) const { return pTriangulator->GetSweepX(a) < pTriangulator->GetSweepX(b); }
+		};
+
+		//Per vertex, edge i runs from vertex i to m_Next[i]
+		const std::vector<Vector2>* m_pVertices = nullptr;
+		std::vector<int> m_Prev{};
+		std::vector<int> m_Next{};
+		std::vector<VertexType> m_Types{};
+		std::vector<int> m_Order{}; //Vertices from top to bottom
+		std::vector<int> m_Helpers{};
+
+		float m_SweepY = 0.f;
+		std::set<int, StatusCompare> m_Status{ StatusCompare{ this } };
+		std::vector<std::set<int, StatusCompare>::iterator> m_StatusIterators{};
+
+		//Half-edges of the monotone pieces (boundary in ring direction, diagonals both ways) grouped per vertex
+		std::vector<std::pair<int, int>> m_Diagonals{};
+		std::vector<int> m_HalfEdgeStarts{};
+		std::vector<int> m_HalfEdgeTargets{};
+		std::vector<bool> m_IsHalfEdgeUsed{};
+
+		std::vector<int> m_Face{};
+		std::vector<bool> m_IsOnLeftChain{};
+		std::vector<int> m_Stack{};
+
+		bool IsAbove(int a, int b) const;
+		float GetSweepX(int key) const;
+		void Classify(int vertex);
+
+		void InsertEdge(int edge, int helper);
+		void RemoveEdge(int edge);
+		int GetLeftEdge(int vertex);
+		void ConnectToHelper(int vertex, int edge);
+		void SweepVertex(int vertex);
+
+		void BuildHalfEdges();
+		int GetNextHalfEdge(int from, int at) const;
+		void TriangulateMonotone(std::vector<std::array<int, 3>>& triangles);
+		void AddTriangle(int a, int b, int c, std::vector<std::array<int, 3>>& triangles) const;
+	};
+}
+#endif
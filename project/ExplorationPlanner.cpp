@@ -0,0 +1,238 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "ExplorationPlanner.h"
+#include <bitset>
+
+void ExplorationPlanner::Initialize(const WorldInfo& world, float fovRange)
+{
+	const float cellSize{ (std::max)(fovRange, 1.f) };
+	m_CellSize = cellSize;
+	m_Columns = static_cast<int>(world.Dimensions.x / cellSize);
+	m_Rows = static_cast<int>(world.Dimensions.y / cellSize);
+	m_Origin = world.Center - world.Dimensions / 2.f;
+	m_Visited.assign((GetCellCount() + m_BitsPerWord - 1) / m_BitsPerWord, 0);
+	m_SeenMap.Initialize(world, cellSize / m_LeavesPerCell);
+	m_Visibility.Initialize(world, cellSize / m_LeavesPerCell);
+	m_Time = 0.f;
+	Reset();
+}
+
+void ExplorationPlanner::Update(const AgentInfo& agent, float dt)
+{
+	if (GetCellCount() == 0)
+		return;
+	m_Time += dt;
+	m_SeenMap.MarkSeen(agent.Position, agent.Orientation, agent.FOV_Angle, agent.FOV_Range);
+	m_Visibility.MarkSeen(agent.Position, agent.Orientation, agent.FOV_Angle, agent.FOV_Range, m_Time);
+
+	//Only the cells the FOV can reach
+	const int minColumn{ (std::max)(static_cast<int>(floorf((agent.Position.x - agent.FOV_Range - m_Origin.x) / m_CellSize)), 0) };
+	const int maxColumn{ (std::min)(static_cast<int>(floorf((agent.Position.x + agent.FOV_Range - m_Origin.x) / m_CellSize)), m_Columns - 1) };
+	const int minRow{ (std::max)(static_cast<int>(floorf((agent.Position.y - agent.FOV_Range - m_Origin.y) / m_CellSize)), 0) };
+	const int maxRow{ (std::min)(static_cast<int>(floorf((agent.Position.y + agent.FOV_Range - m_Origin.y) / m_CellSize)), m_Rows - 1) };
+	for (int row{ minRow }; row <= maxRow; ++row)
+	{
+		for (int column{ minColumn }; column <= maxColumn; ++column)
+		{
+			const int cell{ row * m_Columns + column };
+			const Elite::Vector2 cellMin{ m_Origin + Elite::Vector2{ column * m_CellSize, row * m_CellSize } };
+			if (!IsVisited(cell) && m_SeenMap.IsSeen(cellMin, cellMin + Elite::Vector2{ m_CellSize, m_CellSize }))
+				MarkVisited(cell);
+		}
+	}
+}
+
+int ExplorationPlanner::GetNextCell(const Elite::Vector2& position)
+{
+	if (GetCellCount() == 0)
+		return -1;
+	if (IsComplete())
+	{
+		Reset();
+		StartTour(GetRoundStart(position));
+	}
+	else if (!m_IsTourValid)
+		StartTour(position);
+	ContinueTour();
+
+	//Every cell is skipped once per tour. When the cursor catches up with the ordered part one more cell is ordered,
+	//that one is unvisited, or all are visited and the tour starts over
+	for (;;)
+	{
+		while (m_TourIndex < m_OrderedCount && IsVisited(m_Tour[m_TourIndex]))
+			++m_TourIndex;
+		if (m_TourIndex < m_OrderedCount)
+			return m_Tour[m_TourIndex];
+		if (m_OrderedCount == m_Tour.size())
+		{
+			Reset();
+			StartTour(GetRoundStart(position));
+		}
+		OrderNextCell();
+	}
+}
+
+void ExplorationPlanner::MarkVisited(int cell)
+{
+	if (cell < 0 || cell >= GetCellCount())
+		return;
+	m_Visited[cell / m_BitsPerWord] |= 1ull << (cell % m_BitsPerWord);
+}
+
+void ExplorationPlanner::Reset()
+{
+	std::fill(m_Visited.begin(), m_Visited.end(), 0);
+	m_SeenMap.Reset();
+	m_Tour.clear();
+	m_TourIndex = 0;
+	m_OrderedCount = 0;
+	m_IsTourValid = false;
+}
+
+void ExplorationPlanner::ReplanTour(const Elite::Vector2& position)
+{
+	if (GetCellCount() != 0)
+		StartTour(position);
+}
+
+size_t ExplorationPlanner::GetVisitedCount() const
+{
+	size_t count{};
+	for (const unsigned long long word : m_Visited)
+		count += std::bitset<m_BitsPerWord>(word).count();
+	return count;
+}
+
+int ExplorationPlanner::GetCell(const Elite::Vector2& position) const
+{
+	const int column{ static_cast<int>(floorf((position.x - m_Origin.x) / m_CellSize)) };
+	const int row{ static_cast<int>(floorf((position.y - m_Origin.y) / m_CellSize)) };
+	if (column < 0 || column >= m_Columns || row < 0 || row >= m_Rows)
+		return -1;
+	return row * m_Columns + column;
+}
+
+Elite::Vector2 ExplorationPlanner::GetCellCenter(int cell) const
+{
+	return m_Origin + Elite::Vector2{ (cell % m_Columns + 0.5f) * m_CellSize, (cell / m_Columns + 0.5f) * m_CellSize };
+}
+
+Elite::Vector2 ExplorationPlanner::GetRoundStart(const Elite::Vector2& position) const
+{
+	//The whole world is in range, the tour then orders the stalest cell first and sweeps out from there
+	const float worldRadius{ Elite::Vector2{ m_Columns * m_CellSize, m_Rows * m_CellSize }.Magnitude() };
+	Elite::Vector2 stalest{};
+	return m_Visibility.FindStalest(position, worldRadius, stalest) ? stalest : position;
+}
+
+void ExplorationPlanner::StartTour(const Elite::Vector2& position)
+{
+	m_Tour.clear();
+	m_TourPoints.clear();
+	for (int cell{}; cell < GetCellCount(); ++cell)
+	{
+		if (IsVisited(cell))
+			continue;
+		m_Tour.push_back(cell);
+		m_TourPoints.push_back(GetCellCenter(cell));
+	}
+
+	m_TourStart = position;
+	m_TourIndex = 0;
+	m_OrderedCount = 0;
+	m_TwoOptPass = 0;
+	m_TwoOptI = 1;
+	m_TwoOptJ = 2;
+	m_IsTwoOptImproved = false;
+	m_IsTourValid = true;
+}
+
+void ExplorationPlanner::ContinueTour()
+{
+	size_t work{};
+	while (work < m_TourWorkPerCall && m_OrderedCount < m_Tour.size())
+		work += OrderNextCell();
+	while (work < m_TourWorkPerCall && m_OrderedCount == m_Tour.size() && m_TwoOptPass < m_MaxTwoOptPasses)
+		work += ImproveTourStep();
+}
+
+size_t ExplorationPlanner::OrderNextCell()
+{
+	//Nearest neighbor: the unordered part of the tour is after m_OrderedCount, swap the closest unvisited one to it
+	const size_t i{ m_OrderedCount };
+	const Elite::Vector2 current{ i == 0 ? m_TourStart : m_TourPoints[i - 1] };
+	size_t closestIdx{ m_Tour.size() };
+	float closestDistanceSquared{ (std::numeric_limits<float>::max)() };
+	for (size_t j{ i }; j < m_Tour.size(); ++j)
+	{
+		const float distanceSquared{ Elite::DistanceSquared(current, m_TourPoints[j]) };
+		if (distanceSquared < closestDistanceSquared && !IsVisited(m_Tour[j]))
+		{
+			closestDistanceSquared = distanceSquared;
+			closestIdx = j;
+		}
+	}
+
+	//The rest was visited while the tour was being built, it doesn't need to be ordered anymore
+	if (closestIdx == m_Tour.size())
+	{
+		m_Tour.resize(i);
+		m_TourPoints.resize(i);
+		return m_Tour.size() - i + 1;
+	}
+	std::swap(m_Tour[i], m_Tour[closestIdx]);
+	std::swap(m_TourPoints[i], m_TourPoints[closestIdx]);
+	++m_OrderedCount;
+	return m_Tour.size() - i;
+}
+
+size_t ExplorationPlanner::ImproveTourStep()
+{
+	//One pair of 2-opt on the open tour after the cursor: reversing [i, j] replaces the edges (i - 1, i) and (j, j + 1)
+	//by (i - 1, j) and (i, j + 1). The last cell has no edge after it. The cell the agent walks to (the cursor) stays.
+	const int count{ static_cast<int>(m_Tour.size()) };
+	const int firstI{ static_cast<int>(m_TourIndex) + 1 };
+	if (m_TwoOptI < firstI)
+	{
+		m_TwoOptI = firstI;
+		m_TwoOptJ = firstI + 1;
+	}
+
+	if (m_TwoOptJ < count)
+	{
+		const int i{ m_TwoOptI };
+		const int j{ m_TwoOptJ };
+		const Elite::Vector2& before{ m_TourPoints[i - 1] };
+		const Elite::Vector2& first{ m_TourPoints[i] };
+		const Elite::Vector2& last{ m_TourPoints[j] };
+		float delta{ Elite::Distance(before, last) - Elite::Distance(before, first) };
+		if (j + 1 < count)
+			delta += Elite::Distance(first, m_TourPoints[j + 1]) - Elite::Distance(last, m_TourPoints[j + 1]);
+
+		if (delta < -0.001f)
+		{
+			std::reverse(m_Tour.begin() + i, m_Tour.begin() + j + 1);
+			std::reverse(m_TourPoints.begin() + i, m_TourPoints.begin() + j + 1);
+			m_IsTwoOptImproved = true;
+			++m_TwoOptJ;
+			return static_cast<size_t>(j - i) + 1;
+		}
+		++m_TwoOptJ;
+		return 1;
+	}
+
+	//Next i, a pass ends when i runs out, the last pass is the one without improvement
+	++m_TwoOptI;
+	m_TwoOptJ = m_TwoOptI + 1;
+	if (m_TwoOptI < count - 1)
+		return 1;
+	++m_TwoOptPass;
+	if (!m_IsTwoOptImproved)
+		m_TwoOptPass = m_MaxTwoOptPasses;
+	m_IsTwoOptImproved = false;
+	m_TwoOptI = firstI;
+	m_TwoOptJ = firstI + 1;
+	return 1;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "ExplorationQuadtree.h"
+#include "VisibilityMap.h"
+#include <vector>
+
+//Splits the world in cells as big as the FOV range and keeps which ones the agent has visited in a bitset.
+//A cell is visited once the agent has seen all of it (ExplorationQuadtree) or stood at its center.
+//When each spot was last seen is kept over the rounds (VisibilityMap), to find the areas that were seen the longest ago.
+//The unvisited cells are ordered in one tour (nearest neighbor, improved with 2-opt) from where the agent is when it's started,
+//after a round from the spot that was seen the longest ago.
+//The tour is built a bounded amount of work per GetNextCell, the partial tour is kept between ticks: the cursor walks
+//the cells that are already ordered, skipping cells visited in the meantime, and 2-opt only changes the tour after the cursor.
+class ExplorationPlanner final
+{
+public:
+	ExplorationPlanner() = default;
+	~ExplorationPlanner() = default;
+
+	void Initialize(const WorldInfo& world, float fovRange);
+	//Marks what is in the FOV as seen, every cell around the agent that's completely seen is visited
+	void Update(const AgentInfo& agent, float dt);
+
+	//Next cell of the tour, -1 when there are no cells. Starts over (all unvisited) once the world is explored,
+	//the new tour then begins at the stalest spot instead of at the agent
+	int GetNextCell(const Elite::Vector2& position);
+	void MarkVisited(int cell);
+	//Forgets the visits, what was seen this round and the tour, not when it was seen
+	void Reset();
+	//Starts ordering the unvisited cells again from position, e.g. after the agent left the tour for a while
+	void ReplanTour(const Elite::Vector2& position);
+
+	bool IsVisited(int cell) const { return (m_Visited[cell / m_BitsPerWord] >> (cell % m_BitsPerWord)) & 1u; }
+	size_t GetVisitedCount() const;
+	//The last cell can be out of reach (e.g. in a house), it doesn't hold up the next round
+	bool IsComplete() const { return GetVisitedCount() + 1 >= static_cast<size_t>(GetCellCount()); }
+
+	int GetCellCount() const { return m_Columns * m_Rows; }
+	int GetColumns() const { return m_Columns; }
+	int GetRows() const { return m_Rows; }
+	//-1 outside of the world
+	int GetCell(const Elite::Vector2& position) const;
+	Elite::Vector2 GetCellCenter(int cell) const;
+	//Only the first GetOrderedCount cells are in tour order while it's being built
+	const std::vector<int>& GetTour() const { return m_Tour; }
+	size_t GetOrderedCount() const { return m_OrderedCount; }
+	bool IsTourBuilt() const { return m_OrderedCount == m_Tour.size() && m_TwoOptPass == m_MaxTwoOptPasses; }
+	const ExplorationQuadtree& GetSeenMap() const { return m_SeenMap; }
+	const VisibilityMap& GetVisibility() const { return m_Visibility; }
+	//Time the planner was updated for, the clock of the visibility map
+	float GetTime() const { return m_Time; }
+
+private:
+	static constexpr int m_BitsPerWord = 64;
+	static constexpr int m_MaxTwoOptPasses = 8;
+	static constexpr size_t m_TourWorkPerCall = 4096; //Distance evaluations and moved cells per GetNextCell, a nearest neighbor step always finishes
+	static constexpr float m_LeavesPerCell = 8.f; //Resolution of the seen map along a cell
+
+	Elite::Vector2 m_Origin = {}; //Bottom left of the world
+	float m_CellSize = 1.f;
+	int m_Columns = 0;
+	int m_Rows = 0;
+
+	std::vector<unsigned long long> m_Visited{};
+	ExplorationQuadtree m_SeenMap{};
+	VisibilityMap m_Visibility{};
+	float m_Time = 0.f;
+	std::vector<int> m_Tour{}; //Cells in visiting order
+	std::vector<Elite::Vector2> m_TourPoints{}; //Cell centers of m_Tour, only used while building
+	size_t m_TourIndex = 0;
+	bool m_IsTourValid = false;
+
+	//Build state, kept between calls
+	Elite::Vector2 m_TourStart = {};
+	size_t m_OrderedCount = 0; //m_Tour[0, m_OrderedCount) is in nearest neighbor order, the rest isn't ordered yet
+	int m_TwoOptPass = 0;
+	int m_TwoOptI = 0;
+	int m_TwoOptJ = 0;
+	bool m_IsTwoOptImproved = false;
+
+	//Stalest spot of the visibility map, position when nothing was seen
+	Elite::Vector2 GetRoundStart(const Elite::Vector2& position) const;
+	void StartTour(const Elite::Vector2& position);
+	void ContinueTour();
+	size_t OrderNextCell();
+	size_t ImproveTourStep();
+};
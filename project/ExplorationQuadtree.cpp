@@ -0,0 +1,160 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "ExplorationQuadtree.h"
+
+void ExplorationQuadtree::Initialize(const WorldInfo& world, float leafSize)
+{
+	m_LeafSize = leafSize;
+	m_RootSize = (std::max)(world.Dimensions.x, world.Dimensions.y);
+	m_Origin = world.Center - Elite::Vector2{ m_RootSize, m_RootSize } / 2.f;
+	Reset();
+}
+
+void ExplorationQuadtree::Reset()
+{
+	m_Nodes.assign(1, Node{});
+	m_FreeChildren.clear();
+}
+
+void ExplorationQuadtree::MarkSeen(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange)
+{
+	ViewCone cone{};
+	cone.Position = position;
+	cone.Direction = Elite::OrientationToVector(orientation);
+	cone.CosHalfAngle = cosf(fovAngle / 2.f);
+	cone.Range = fovRange;
+	cone.IsConvex = fovAngle <= static_cast<float>(E_PI);
+	MarkSeen(0, m_Origin, m_RootSize, cone);
+}
+
+bool ExplorationQuadtree::IsSeen(const Elite::Vector2& min, const Elite::Vector2& max) const
+{
+	return IsSeen(0, m_Origin, m_RootSize, min, max);
+}
+
+void ExplorationQuadtree::MarkSeen(int nodeIdx, const Elite::Vector2& min, float size, const ViewCone& cone)
+{
+	if (m_Nodes[nodeIdx].State == NodeState::Seen)
+		return;
+
+	const Elite::Vector2 max{ min + Elite::Vector2{ size, size } };
+	if (!cone.Overlaps(min, max))
+		return;
+	if (cone.Contains(min, max))
+	{
+		Collapse(nodeIdx, NodeState::Seen);
+		return;
+	}
+	if (size <= m_LeafSize)
+	{
+		if (cone.Contains(min + Elite::Vector2{ size, size } / 2.f))
+			Collapse(nodeIdx, NodeState::Seen);
+		return;
+	}
+
+	//Partly in the cone, continue in the children
+	if (m_Nodes[nodeIdx].State == NodeState::Unseen)
+		Split(nodeIdx);
+	const int firstChild{ m_Nodes[nodeIdx].FirstChild };
+	const float halfSize{ size / 2.f };
+	bool isAllSeen{ true };
+	for (int child{}; child < 4; ++child)
+	{
+		MarkSeen(firstChild + child, GetChildMin(min, halfSize, child), halfSize, cone);
+		isAllSeen = isAllSeen && m_Nodes[firstChild + child].State == NodeState::Seen;
+	}
+	if (isAllSeen)
+		Collapse(nodeIdx, NodeState::Seen);
+}
+
+bool ExplorationQuadtree::IsSeen(int nodeIdx, const Elite::Vector2& nodeMin, float size, const Elite::Vector2& min, const Elite::Vector2& max) const
+{
+	//Rects that only touch don't overlap
+	if (max.x <= nodeMin.x || max.y <= nodeMin.y || min.x >= nodeMin.x + size || min.y >= nodeMin.y + size)
+		return true;
+
+	const Node& node{ m_Nodes[nodeIdx] };
+	if (node.State != NodeState::Mixed)
+		return node.State == NodeState::Seen;
+
+	const float halfSize{ size / 2.f };
+	for (int child{}; child < 4; ++child)
+	{
+		if (!IsSeen(node.FirstChild + child, GetChildMin(nodeMin, halfSize, child), halfSize, min, max))
+			return false;
+	}
+	return true;
+}
+
+float ExplorationQuadtree::GetSeenArea(int nodeIdx, float size) const
+{
+	const Node& node{ m_Nodes[nodeIdx] };
+	if (node.State != NodeState::Mixed)
+		return node.State == NodeState::Seen ? size * size : 0.f;
+
+	float area{};
+	for (int child{}; child < 4; ++child)
+		area += GetSeenArea(node.FirstChild + child, size / 2.f);
+	return area;
+}
+
+void ExplorationQuadtree::Split(int nodeIdx)
+{
+	int firstChild{};
+	if (!m_FreeChildren.empty())
+	{
+		firstChild = m_FreeChildren.back();
+		m_FreeChildren.pop_back();
+		std::fill(m_Nodes.begin() + firstChild, m_Nodes.begin() + firstChild + 4, Node{});
+	}
+	else
+	{
+		firstChild = static_cast<int>(m_Nodes.size());
+		m_Nodes.resize(m_Nodes.size() + 4);
+	}
+	m_Nodes[nodeIdx].State = NodeState::Mixed;
+	m_Nodes[nodeIdx].FirstChild = firstChild;
+}
+
+void ExplorationQuadtree::Collapse(int nodeIdx, NodeState state)
+{
+	const int firstChild{ m_Nodes[nodeIdx].FirstChild };
+	if (firstChild != -1)
+	{
+		for (int child{}; child < 4; ++child)
+			Collapse(firstChild + child, state);
+		m_FreeChildren.push_back(firstChild);
+	}
+	m_Nodes[nodeIdx].State = state;
+	m_Nodes[nodeIdx].FirstChild = -1;
+}
+
+Elite::Vector2 ExplorationQuadtree::GetChildMin(const Elite::Vector2& min, float halfSize, int child)
+{
+	return min + Elite::Vector2{ (child & 1) * halfSize, (child >> 1) * halfSize };
+}
+
+bool ExplorationQuadtree::ViewCone::Contains(const Elite::Vector2& point) const
+{
+	const Elite::Vector2 toPoint{ point - Position };
+	const float distanceSquared{ toPoint.SqrtMagnitude() };
+	if (distanceSquared > Range * Range)
+		return false;
+	return Elite::Dot(toPoint, Direction) >= sqrtf(distanceSquared) * CosHalfAngle;
+}
+
+bool ExplorationQuadtree::ViewCone::Overlaps(const Elite::Vector2& min, const Elite::Vector2& max) const
+{
+	//Against the circle of the range, the cone test is left to the children
+	const Elite::Vector2 closest{ Elite::Clamp(Position.x, min.x, max.x), Elite::Clamp(Position.y, min.y, max.y) };
+	return Elite::DistanceSquared(closest, Position) <= Range * Range;
+}
+
+bool ExplorationQuadtree::ViewCone::Contains(const Elite::Vector2& min, const Elite::Vector2& max) const
+{
+	return IsConvex
+		&& Contains(min) && Contains(max)
+		&& Contains(Elite::Vector2{ min.x, max.y }) && Contains(Elite::Vector2{ max.x, min.y });
+}
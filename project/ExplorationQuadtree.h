@@ -0,0 +1,65 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+//Region quadtree over the world that remembers what the agent has seen.
+//Only the border between seen and unseen is subdivided (down to the leaf size), four seen siblings merge into their parent,
+//so the memory follows the length of that border instead of the size of the world.
+class ExplorationQuadtree final
+{
+public:
+	ExplorationQuadtree() = default;
+	~ExplorationQuadtree() = default;
+
+	void Initialize(const WorldInfo& world, float leafSize);
+	void Reset();
+
+	//Marks the part of the world in the view cone as seen, a leaf counts when its center is in the cone
+	void MarkSeen(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange);
+	//True when all of the rect was seen
+	bool IsSeen(const Elite::Vector2& min, const Elite::Vector2& max) const;
+
+	float GetSeenArea() const { return GetSeenArea(0, m_RootSize); }
+	float GetLeafSize() const { return m_LeafSize; }
+	size_t GetNodeCount() const { return m_Nodes.size() - m_FreeChildren.size() * 4; }
+
+private:
+	enum class NodeState : unsigned char
+	{
+		Unseen,
+		Seen,
+		Mixed //Has children
+	};
+
+	struct Node final
+	{
+		NodeState State = NodeState::Unseen;
+		int FirstChild = -1; //The four children are stored after each other
+	};
+
+	struct ViewCone final
+	{
+		Elite::Vector2 Position = {};
+		Elite::Vector2 Direction = {};
+		float CosHalfAngle = 0.f;
+		float Range = 0.f;
+		bool IsConvex = false; //Angle of at most 180 degrees, then a rect with its corners in the cone is in it
+
+		bool Contains(const Elite::Vector2& point) const;
+		bool Overlaps(const Elite::Vector2& min, const Elite::Vector2& max) const;
+		bool Contains(const Elite::Vector2& min, const Elite::Vector2& max) const;
+	};
+
+	std::vector<Node> m_Nodes{}; //Root first
+	std::vector<int> m_FreeChildren{}; //First child of released groups of four
+	Elite::Vector2 m_Origin = {}; //Bottom left of the root
+	float m_RootSize = 0.f;
+	float m_LeafSize = 1.f;
+
+	void MarkSeen(int nodeIdx, const Elite::Vector2& min, float size, const ViewCone& cone);
+	bool IsSeen(int nodeIdx, const Elite::Vector2& nodeMin, float size, const Elite::Vector2& min, const Elite::Vector2& max) const;
+	float GetSeenArea(int nodeIdx, float size) const;
+	void Split(int nodeIdx);
+	void Collapse(int nodeIdx, NodeState state);
+	static Elite::Vector2 GetChildMin(const Elite::Vector2& min, float halfSize, int child);
+};
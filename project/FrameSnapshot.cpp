@@ -0,0 +1,125 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "FrameSnapshot.h"
+#include "IExamInterface.h"
+
+void FrameSnapshot::Update(IExamInterface* pInterface)
+{
+	m_pInterface = pInterface;
+	m_Agent = m_pInterface->Agent_GetInfo();
+	m_CapturedParts = 0;
+
+	float sine{}, cosine{};
+	Elite::SinCosFst(m_Agent.Orientation, sine, cosine);
+	m_AgentBasis.Side = Elite::Vector2{ cosine, sine };
+	m_AgentBasis.Forward = Elite::Vector2{ sine, -cosine };
+}
+
+const WorldInfo& FrameSnapshot::GetWorld() const
+{
+	if (!(m_CapturedParts & World))
+	{
+		m_World = m_pInterface->World_GetInfo();
+		m_CapturedParts |= World;
+	}
+	return m_World;
+}
+
+const StatisticsInfo& FrameSnapshot::GetStats() const
+{
+	if (!(m_CapturedParts & Stats))
+	{
+		m_Stats = m_pInterface->World_GetStats();
+		m_CapturedParts |= Stats;
+	}
+	return m_Stats;
+}
+
+const std::vector<HouseInfo>& FrameSnapshot::GetHousesInFOV() const
+{
+	if (!(m_CapturedParts & Houses))
+	{
+		m_HousesInFOV.clear();
+		HouseInfo hi = {};
+		for (UINT i = 0; m_pInterface->Fov_GetHouseByIndex(i, hi); ++i)
+			m_HousesInFOV.push_back(hi);
+		m_CapturedParts |= Houses;
+	}
+	return m_HousesInFOV;
+}
+
+const std::vector<EntityInfo>& FrameSnapshot::GetEntitiesInFOV() const
+{
+	if (!(m_CapturedParts & Entities))
+	{
+		m_EntitiesInFOV.clear();
+		EntityInfo ei = {};
+		for (UINT i = 0; m_pInterface->Fov_GetEntityByIndex(i, ei); ++i)
+			m_EntitiesInFOV.push_back(ei);
+		m_CapturedParts |= Entities;
+	}
+	return m_EntitiesInFOV;
+}
+
+const PerceptionBuffers& FrameSnapshot::GetPerception() const
+{
+	if (!(m_CapturedParts & Perception))
+	{
+		//Single pass: every entity is queried for its typed info once and appended to the matching buffers
+		m_Perception.Clear();
+		for (const EntityInfo& ei : GetEntitiesInFOV())
+		{
+			switch (ei.Type)
+			{
+			case eEntityType::ENEMY:
+			{
+				EnemyInfo enemy = {};
+				m_pInterface->Enemy_GetInfo(ei, enemy);
+				m_Perception.Enemies.push_back(enemy);
+				m_Perception.EnemyPositionsX.push_back(enemy.Location.x);
+				m_Perception.EnemyPositionsY.push_back(enemy.Location.y);
+				m_Perception.EnemyVelocitiesX.push_back(enemy.LinearVelocity.x);
+				m_Perception.EnemyVelocitiesY.push_back(enemy.LinearVelocity.y);
+				break;
+			}
+			case eEntityType::ITEM:
+			{
+				ItemInfo item = {};
+				m_pInterface->Item_GetInfo(ei, item);
+				m_Perception.ItemEntities.push_back(ei);
+				m_Perception.Items.push_back(item);
+				m_Perception.ItemPositionsX.push_back(item.Location.x);
+				m_Perception.ItemPositionsY.push_back(item.Location.y);
+				break;
+			}
+			case eEntityType::PURGEZONE:
+			{
+				PurgeZoneInfo zone = {};
+				m_pInterface->PurgeZone_GetInfo(ei, zone);
+				m_Perception.PurgeZones.push_back(zone);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+		m_CapturedParts |= Perception;
+	}
+	return m_Perception;
+}
+
+void PerceptionBuffers::Clear()
+{
+	Enemies.clear();
+	EnemyPositionsX.clear();
+	EnemyPositionsY.clear();
+	EnemyVelocitiesX.clear();
+	EnemyVelocitiesY.clear();
+	ItemEntities.clear();
+	Items.clear();
+	ItemPositionsX.clear();
+	ItemPositionsY.clear();
+	PurgeZones.clear();
+}
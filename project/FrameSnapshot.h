@@ -0,0 +1,88 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "NavigationCache.h"
+
+class IExamInterface;
+
+//Typed results of one sweep over the entities in FOV. Info and position arrays of a type share their index,
+//the positions (and enemy velocities) are also kept as separate x/y arrays so scans run over contiguous floats.
+//Cleared every tick, the vectors keep their capacity so a steady state tick doesn't allocate.
+struct PerceptionBuffers final
+{
+	std::vector<EnemyInfo> Enemies{};
+	std::vector<float> EnemyPositionsX{};
+	std::vector<float> EnemyPositionsY{};
+	std::vector<float> EnemyVelocitiesX{};
+	std::vector<float> EnemyVelocitiesY{};
+
+	std::vector<EntityInfo> ItemEntities{}; //Needed for Item_Grab
+	std::vector<ItemInfo> Items{};
+	std::vector<float> ItemPositionsX{};
+	std::vector<float> ItemPositionsY{};
+
+	std::vector<PurgeZoneInfo> PurgeZones{};
+
+	void Clear();
+};
+
+//Axes of the agent, from one SinCosFst of its orientation per tick
+struct AgentBasis final
+{
+	Elite::Vector2 Forward{}; //OrientationToVector(Orientation)
+	Elite::Vector2 Side{}; //(cos, sin) of Orientation, Forward turned 90 degrees counterclockwise
+};
+
+//All host queries of one tick, captured once at the start of UpdateSteering so nothing crosses the DLL boundary twice.
+//The agent is always captured, the other parts only on their first use that tick.
+class FrameSnapshot final
+{
+public:
+	FrameSnapshot() = default;
+	~FrameSnapshot() = default;
+
+	//Start of a new tick
+	void Update(IExamInterface* pInterface);
+
+	const AgentInfo& GetAgent() const { return m_Agent; }
+	const AgentBasis& GetAgentBasis() const { return m_AgentBasis; }
+	const WorldInfo& GetWorld() const;
+	const StatisticsInfo& GetStats() const;
+	const std::vector<HouseInfo>& GetHousesInFOV() const;
+	const std::vector<EntityInfo>& GetEntitiesInFOV() const;
+	const PerceptionBuffers& GetPerception() const;
+
+	//NavMesh_GetClosestPathPoint through a cache that persists between ticks
+	Elite::Vector2 GetClosestPathPoint(const Elite::Vector2& target) const { return m_Navigation.GetClosestPathPoint(m_pInterface, m_Agent.Position, target); }
+	const NavigationCache& GetNavigation() const { return m_Navigation; }
+#ifdef USE_LOCAL_NAVMESH
+	//Feeds the houses in FOV to the local navmesh
+	void UpdateNavMesh() { m_Navigation.UpdateNavMesh(GetWorld(), GetHousesInFOV()); }
+#endif
+
+	//Non-query calls (inventory, debug drawing) still go through the interface
+	IExamInterface* GetInterface() const { return m_pInterface; }
+
+private:
+	enum CapturedParts : unsigned char
+	{
+		World = 1 << 0,
+		Stats = 1 << 1,
+		Houses = 1 << 2,
+		Entities = 1 << 3,
+		Perception = 1 << 4
+	};
+
+	IExamInterface* m_pInterface = nullptr;
+	AgentInfo m_Agent{};
+	AgentBasis m_AgentBasis{};
+
+	//Lazy parts, the containers keep their capacity between ticks
+	mutable unsigned char m_CapturedParts = 0;
+	mutable WorldInfo m_World{};
+	mutable StatisticsInfo m_Stats{};
+	mutable std::vector<HouseInfo> m_HousesInFOV{};
+	mutable std::vector<EntityInfo> m_EntitiesInFOV{};
+	mutable PerceptionBuffers m_Perception{};
+
+	mutable NavigationCache m_Navigation{};
+};
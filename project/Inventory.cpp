@@ -0,0 +1,106 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "Inventory.h"
+#include "IExamInterface.h"
+#include <bitset>
+
+void Inventory::Initialize(IExamInterface* pInterface)
+{
+	m_pInterface = pInterface;
+	m_Capacity = (std::min)(static_cast<unsigned int>(pInterface->Inventory_GetCapacity()), m_MaxSlots);
+	m_AllSlotsMask = m_Capacity == m_MaxSlots ? ~0u : (1u << m_Capacity) - 1u;
+	m_OccupiedMask = 0;
+	m_TypeMasks.fill(0);
+	m_BestPistolSlot = m_InvalidSlot;
+}
+
+unsigned int Inventory::Add(const ItemInfo& item)
+{
+	const unsigned int slot{ GetFirstFreeSlot() };
+	if (slot == m_InvalidSlot || !m_pInterface->Inventory_AddItem(slot, item))
+		return m_InvalidSlot;
+
+	m_Items[slot] = item;
+	m_OccupiedMask |= 1u << slot;
+	if (static_cast<size_t>(item.Type) < m_TypeCount)
+		m_TypeMasks[static_cast<size_t>(item.Type)] |= 1u << slot;
+	m_Values[slot] = ReadValue(slot);
+	if (item.Type == eItemType::PISTOL)
+		UpdateBestPistol();
+	return slot;
+}
+
+bool Inventory::Use(unsigned int slot)
+{
+	if (slot >= m_Capacity || !IsOccupied(slot) || !m_pInterface->Inventory_UseItem(slot))
+		return false;
+
+	m_Values[slot] = ReadValue(slot);
+	if (m_Items[slot].Type == eItemType::PISTOL)
+		UpdateBestPistol();
+	return true;
+}
+
+void Inventory::Remove(unsigned int slot)
+{
+	if (slot >= m_Capacity || !IsOccupied(slot))
+		return;
+
+	m_pInterface->Inventory_RemoveItem(slot);
+	m_OccupiedMask &= ~(1u << slot);
+	for (unsigned int& typeMask : m_TypeMasks)
+		typeMask &= ~(1u << slot);
+	m_Values[slot] = 0;
+	if (m_Items[slot].Type == eItemType::PISTOL)
+		UpdateBestPistol();
+}
+
+int Inventory::GetTotalValue(eItemType type) const
+{
+	int total{};
+	for (unsigned int slots{ GetSlotsOfType(type) }; slots != 0; slots &= slots - 1)
+		total += m_Values[GetLowestBit(slots)];
+	return total;
+}
+
+unsigned int Inventory::GetLowestBit(unsigned int mask)
+{
+	//De Bruijn multiplication: isolating the lowest bit and multiplying puts a unique pattern in the top 5 bits
+	static constexpr unsigned int lookup[32]{ 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+		31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+	return lookup[((mask & (~mask + 1u)) * 0x077CB531u) >> 27];
+}
+
+int Inventory::GetBitCount(unsigned int mask)
+{
+	return static_cast<int>(std::bitset<m_MaxSlots>(mask).count());
+}
+
+int Inventory::ReadValue(unsigned int slot)
+{
+	ItemInfo& item{ m_Items[slot] };
+	switch (item.Type)
+	{
+	case eItemType::PISTOL:
+		return m_pInterface->Weapon_GetAmmo(item);
+	case eItemType::MEDKIT:
+		return m_pInterface->Medkit_GetHealth(item);
+	case eItemType::FOOD:
+		return m_pInterface->Food_GetEnergy(item);
+	default:
+		return 0;
+	}
+}
+
+void Inventory::UpdateBestPistol()
+{
+	m_BestPistolSlot = m_InvalidSlot;
+	for (unsigned int slots{ GetSlotsOfType(eItemType::PISTOL) }; slots != 0; slots &= slots - 1)
+	{
+		const unsigned int slot{ GetLowestBit(slots) };
+		if (m_BestPistolSlot == m_InvalidSlot || m_Values[slot] < m_Values[m_BestPistolSlot])
+			m_BestPistolSlot = slot;
+	}
+}
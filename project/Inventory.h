@@ -0,0 +1,63 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include <array>
+class IExamInterface;
+
+//The agent's inventory: a fixed array of slots (as many as Inventory_GetCapacity(), at most m_MaxSlots)
+//with a bitmask of the occupied slots and one per item type, so "has type", "how many" and "first free" are a few bit operations.
+//Every slot caches the value of its item (ammo, health or energy), it's read from the interface when the item is added or used,
+//the pistol to shoot with is picked on those changes too.
+//All inventory changes go through here so the interface and the slots stay in sync.
+class Inventory final
+{
+public:
+	static constexpr unsigned int m_MaxSlots = 32; //Bits in a mask
+	static constexpr unsigned int m_InvalidSlot = m_MaxSlots;
+
+	Inventory() = default;
+	~Inventory() = default;
+
+	void Initialize(IExamInterface* pInterface);
+
+	//Puts the item in the first free slot, returns that slot or m_InvalidSlot when it's full
+	unsigned int Add(const ItemInfo& item);
+	//Uses the item and refreshes its value, returns false when the interface refused
+	bool Use(unsigned int slot);
+	void Remove(unsigned int slot);
+
+	bool IsOccupied(unsigned int slot) const { return (m_OccupiedMask >> slot) & 1u; }
+	bool HasFreeSlot() const { return m_OccupiedMask != m_AllSlotsMask; }
+	bool HasType(eItemType type) const { return GetSlotsOfType(type) != 0; }
+	int GetCountOfType(eItemType type) const { return GetBitCount(GetSlotsOfType(type)); }
+	//Bit i is set when slot i holds an item of type
+	unsigned int GetSlotsOfType(eItemType type) const { return m_TypeMasks[static_cast<size_t>(type)]; }
+	unsigned int GetFirstFreeSlot() const { return HasFreeSlot() ? GetLowestBit(~m_OccupiedMask & m_AllSlotsMask) : m_InvalidSlot; }
+	unsigned int GetFirstSlotOfType(eItemType type) const { return HasType(type) ? GetLowestBit(GetSlotsOfType(type)) : m_InvalidSlot; }
+	//The pistol with the least ammo, so guns are emptied (and dropped) one at a time. m_InvalidSlot without pistols
+	unsigned int GetBestPistolSlot() const { return m_BestPistolSlot; }
+
+	const ItemInfo& GetItem(unsigned int slot) const { return m_Items[slot]; }
+	int GetValue(unsigned int slot) const { return m_Values[slot]; }
+	//Sum of the values of all items of type, e.g. the ammo over all pistols
+	int GetTotalValue(eItemType type) const;
+	unsigned int GetCapacity() const { return m_Capacity; }
+
+	//Index of the lowest set bit, mask can't be 0
+	static unsigned int GetLowestBit(unsigned int mask);
+	static int GetBitCount(unsigned int mask);
+
+private:
+	static constexpr size_t m_TypeCount = static_cast<size_t>(eItemType::_LAST) + 1;
+
+	IExamInterface* m_pInterface = nullptr;
+	std::array<ItemInfo, m_MaxSlots> m_Items{};
+	std::array<int, m_MaxSlots> m_Values{};
+	std::array<unsigned int, m_TypeCount> m_TypeMasks{};
+	unsigned int m_OccupiedMask = 0;
+	unsigned int m_AllSlotsMask = 0; //A bit for every slot within the capacity
+	unsigned int m_Capacity = 0;
+	unsigned int m_BestPistolSlot = m_InvalidSlot;
+
+	int ReadValue(unsigned int slot);
+	void UpdateBestPistol();
+};
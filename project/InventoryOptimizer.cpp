@@ -0,0 +1,168 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "InventoryOptimizer.h"
+#include "IExamInterface.h"
+
+void InventoryPlan::Clear()
+{
+	Uses.clear();
+	Drops.clear();
+	Pickups.clear();
+	Value = 0.f;
+}
+
+const InventoryPlan& InventoryOptimizer::Optimize(const AgentInfo& agent, const Inventory& inventory, const std::vector<ItemInfo>& items, IExamInterface* pInterface)
+{
+	m_Values.resize(items.size());
+	for (size_t i{}; i < items.size(); ++i)
+	{
+		ItemInfo item{ items[i] };
+		switch (item.Type)
+		{
+		case eItemType::PISTOL:
+			m_Values[i] = pInterface->Weapon_GetAmmo(item);
+			break;
+		case eItemType::MEDKIT:
+			m_Values[i] = pInterface->Medkit_GetHealth(item);
+			break;
+		case eItemType::FOOD:
+			m_Values[i] = pInterface->Food_GetEnergy(item);
+			break;
+		default:
+			m_Values[i] = 0;
+			break;
+		}
+	}
+	return Optimize(agent, inventory, items, m_Values);
+}
+
+const InventoryPlan& InventoryOptimizer::Optimize(const AgentInfo& agent, const Inventory& inventory, const std::vector<ItemInfo>& items, const std::vector<int>& values)
+{
+	m_Plan.Clear();
+	for (std::vector<Option>& options : m_Options)
+		options.clear();
+
+	//Use what is fully absorbed, the stats after that decide what the rest is worth
+	AgentInfo agentAfterUse{ agent };
+	for (unsigned int slot{}; slot < inventory.GetCapacity(); ++slot)
+	{
+		if (!inventory.IsOccupied(slot))
+			continue;
+		const eItemType type{ inventory.GetItem(slot).Type };
+		const float value{ static_cast<float>(inventory.GetValue(slot)) };
+		if (type == eItemType::FOOD && agentAfterUse.Energy + value <= m_MaxStat)
+		{
+			agentAfterUse.Energy += value;
+			m_Plan.Uses.push_back(slot);
+		}
+		else if (type == eItemType::MEDKIT && agentAfterUse.Health + value <= m_MaxStat)
+		{
+			agentAfterUse.Health += value;
+			m_Plan.Uses.push_back(slot);
+		}
+	}
+
+	//Held items that are left and candidates worth the walk
+	for (unsigned int slot{}; slot < inventory.GetCapacity(); ++slot)
+	{
+		if (!inventory.IsOccupied(slot) || std::find(m_Plan.Uses.cbegin(), m_Plan.Uses.cend(), slot) != m_Plan.Uses.cend())
+			continue;
+		const eItemType type{ inventory.GetItem(slot).Type };
+		if (static_cast<size_t>(type) >= m_TypeCount)
+			continue;
+		Option option{};
+		option.Score = GetScore(type, inventory.GetValue(slot), agentAfterUse);
+		option.Slot = slot;
+		option.IsHeld = true;
+		m_Options[static_cast<size_t>(type)].push_back(option);
+	}
+	for (size_t i{}; i < items.size(); ++i)
+	{
+		if (static_cast<size_t>(items[i].Type) >= m_TypeCount)
+			continue;
+		Option option{};
+		option.Distance = Elite::Distance(agent.Position, items[i].Location);
+		option.Score = GetScore(items[i].Type, values[i], agentAfterUse) - m_Weights.DistanceCost * option.Distance;
+		option.ItemIdx = i;
+		if (option.Score > 0.f)
+			m_Options[static_cast<size_t>(items[i].Type)].push_back(option);
+	}
+	for (std::vector<Option>& options : m_Options)
+	{
+		std::sort(options.begin(), options.end(), [](const Option& a, const Option& b)
+			{
+				return a.Score > b.Score || (a.Score == b.Score && a.IsHeld && !b.IsHeld);
+			});
+	}
+
+	//m_Best[t][c]: best value of the first t types in c slots. Taking n of a type takes its n best options,
+	//fewer items win a tie so worthless items are dropped
+	const int slotCount{ static_cast<int>(inventory.GetCapacity()) };
+	const int stride{ slotCount + 1 };
+	m_Best.assign(stride * (m_TypeCount + 1), 0.f);
+	m_Counts.assign(stride * (m_TypeCount + 1), 0);
+	for (size_t type{}; type < m_TypeCount; ++type)
+	{
+		const std::vector<Option>& options{ m_Options[type] };
+		const float* pPrevious{ m_Best.data() + type * stride };
+		float* pBest{ m_Best.data() + (type + 1) * stride };
+		int* pCounts{ m_Counts.data() + (type + 1) * stride };
+		for (int slots{}; slots <= slotCount; ++slots)
+		{
+			pBest[slots] = pPrevious[slots];
+			float typeValue{};
+			float copyWeight{ 1.f };
+			const int maxCount{ (std::min)(slots, static_cast<int>(options.size())) };
+			for (int count{ 1 }; count <= maxCount; ++count)
+			{
+				typeValue += copyWeight * options[count - 1].Score;
+				copyWeight *= m_Weights.CopyDecay;
+				if (pPrevious[slots - count] + typeValue > pBest[slots])
+				{
+					pBest[slots] = pPrevious[slots - count] + typeValue;
+					pCounts[slots] = count;
+				}
+			}
+		}
+	}
+	m_Plan.Value = m_Best[m_TypeCount * stride + slotCount];
+
+	//Walk back over the types, what is kept stays or is picked up, the other held items are dropped
+	int slots{ slotCount };
+	for (size_t type{ m_TypeCount }; type > 0; --type)
+	{
+		const std::vector<Option>& options{ m_Options[type - 1] };
+		const int count{ m_Counts[type * stride + slots] };
+		for (int i{}; i < static_cast<int>(options.size()); ++i)
+		{
+			if (i < count && !options[i].IsHeld)
+				m_Plan.Pickups.push_back(options[i].ItemIdx);
+			else if (i >= count && options[i].IsHeld)
+				m_Plan.Drops.push_back(options[i].Slot);
+		}
+		slots -= count;
+	}
+	std::sort(m_Plan.Pickups.begin(), m_Plan.Pickups.end(), [&agent, &items](size_t a, size_t b)
+		{
+			return Elite::DistanceSquared(agent.Position, items[a].Location) < Elite::DistanceSquared(agent.Position, items[b].Location);
+		});
+	return m_Plan;
+}
+
+float InventoryOptimizer::GetScore(eItemType type, int value, const AgentInfo& agent) const
+{
+	//Health and energy are worth up to twice as much when the stat is empty
+	switch (type)
+	{
+	case eItemType::PISTOL:
+		return m_Weights.Ammo * value;
+	case eItemType::MEDKIT:
+		return m_Weights.Health * value * (2.f - agent.Health / m_MaxStat);
+	case eItemType::FOOD:
+		return m_Weights.Energy * value * (2.f - agent.Energy / m_MaxStat);
+	default:
+		return 0.f;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "Inventory.h"
+#include <array>
+#include <vector>
+class IExamInterface;
+
+//What to do with the inventory to get to the best one, filled by InventoryOptimizer
+struct InventoryPlan final
+{
+	std::vector<unsigned int> Uses{}; //Slots to use now, every item is fully absorbed
+	std::vector<unsigned int> Drops{}; //Slots to empty, worthless or pushed out by a pickup
+	std::vector<size_t> Pickups{}; //Indices into the candidate items, closest first
+	float Value = 0.f; //Survival value of the inventory after the plan
+
+	void Clear();
+	bool IsEmpty() const { return Uses.empty() && Drops.empty() && Pickups.empty(); }
+};
+
+//Picks the inventory with the highest survival value out of the held items and the candidate items (in the FOV or remembered).
+//An item is worth its value (ammo, health, energy) times a weight, health and energy weigh more the lower the agent's stat is,
+//a candidate loses a bit per unit of distance to it. Every next item of the same type is worth CopyDecay times less,
+//so the best n items of a type are simply its n highest scores, and a small DP over the types and the free slots
+//(a knapsack where every item takes one slot) finds how many of each type to keep exactly.
+//Food and medkits that are fully absorbed are used first, they free their slot.
+class InventoryOptimizer final
+{
+public:
+	struct Weights final
+	{
+		float Ammo = 1.f;
+		float Health = 2.f;
+		float Energy = 1.5f;
+		float CopyDecay = 0.5f; //Worth of the k-th copy of a type is CopyDecay^k
+		float DistanceCost = 0.05f; //Value lost per unit of distance to a candidate
+	};
+
+	InventoryOptimizer() = default;
+	~InventoryOptimizer() = default;
+
+	//Reads the values of the candidate items through the interface
+	const InventoryPlan& Optimize(const AgentInfo& agent, const Inventory& inventory, const std::vector<ItemInfo>& items, IExamInterface* pInterface);
+	//values[i] is the ammo, health or energy of items[i]
+	const InventoryPlan& Optimize(const AgentInfo& agent, const Inventory& inventory, const std::vector<ItemInfo>& items, const std::vector<int>& values);
+
+	void SetWeights(const Weights& weights) { m_Weights = weights; }
+	const Weights& GetWeights() const { return m_Weights; }
+	const InventoryPlan& GetPlan() const { return m_Plan; }
+
+	static constexpr float m_MaxStat = 10.f; //Max health and energy
+
+private:
+	static constexpr size_t m_TypeCount = static_cast<size_t>(eItemType::_LAST) + 1;
+
+	//A held or a candidate item
+	struct Option final
+	{
+		float Score = 0.f;
+		float Distance = 0.f;
+		unsigned int Slot = Inventory::m_InvalidSlot; //Held items only
+		size_t ItemIdx = 0; //Candidates only
+		bool IsHeld = false;
+	};
+
+	Weights m_Weights{};
+	InventoryPlan m_Plan{};
+	std::array<std::vector<Option>, m_TypeCount> m_Options{}; //Per type, highest score first
+	std::vector<int> m_Values{};
+	std::vector<float> m_Best{}; //(types + 1) x (slots + 1), best value of the first types in that many slots
+	std::vector<int> m_Counts{}; //Same layout, how many of the last type that took
+
+	float GetScore(eItemType type, int value, const AgentInfo& agent) const;
+};
@@ -0,0 +1,238 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "LocalNavMesh.h"
+#include "ENavigation.h"
+#include "EAStar.h"
+
+using namespace Elite;
+
+LocalNavMesh::~LocalNavMesh()
+{
+	Release();
+}
+
+bool LocalNavMesh::Update(const WorldInfo& world, const std::vector<HouseInfo>& houses)
+{
+	bool isChanged{ !IsBuilt() || m_World.Center != world.Center || m_World.Dimensions != world.Dimensions };
+	bool isSkipped{ false };
+	m_World = world;
+
+	for (const HouseInfo& house : houses)
+	{
+		if (IsKnownHouse(house))
+			continue;
+		if (IsValidHole(house))
+		{
+			m_Houses.push_back(house);
+			isChanged = true;
+		}
+		else
+		{
+			m_SkippedHouses.push_back(house);
+			isSkipped = true;
+		}
+	}
+
+	if (isChanged)
+		Build();
+	return isChanged || isSkipped;
+}
+
+bool LocalNavMesh::FindPath(const Vector2& start, const Vector2& goal, std::vector<Vector2>& path, size_t maxCorners)
+{
+	path.clear();
+	if (!IsBuilt())
+		return false;
+
+	const Triangle* pStartTriangle{ m_pNavMeshPolygon->GetTriangleFromPositionNear(start, m_pStartTriangle, true) };
+	const Triangle* pGoalTriangle{ m_pNavMeshPolygon->GetTriangleFromPositionNear(goal, m_pGoalTriangle, true) };
+	if (!pStartTriangle || !pGoalTriangle)
+		return false;
+	m_pStartTriangle = pStartTriangle;
+	m_pGoalTriangle = pGoalTriangle;
+
+	if (pStartTriangle == pGoalTriangle)
+	{
+		//Triangles are convex, nothing is in the way
+		path.push_back(goal);
+		if (&path != &m_Path)
+			m_Path = path;
+		return true;
+	}
+
+	//Hook the start and goal nodes onto the portals of their triangles
+	NavGraphNode* pStartNode{ m_pNavGraph->GetNode(m_StartNodeIdx) };
+	NavGraphNode* pGoalNode{ m_pNavGraph->GetNode(m_GoalNodeIdx) };
+	m_pNavGraph->RemoveConnectionsToAdjacentNodes(m_StartNodeIdx);
+	m_pNavGraph->RemoveConnectionsToAdjacentNodes(m_GoalNodeIdx);
+	pStartNode->SetPosition(start);
+	pGoalNode->SetPosition(goal);
+	ConnectToTriangle(m_StartNodeIdx, pStartTriangle);
+	ConnectToTriangle(m_GoalNodeIdx, pGoalTriangle);
+
+	AStar<NavGraphNode, GraphConnection2D> pathfinder{ m_pNavGraph, HeuristicFunctions::Euclidean };
+	const std::vector<NavGraphNode*> nodePath{ pathfinder.FindPath(pStartNode, pGoalNode) };
+	if (nodePath.empty() || nodePath.back() != pGoalNode)
+		return false;
+
+	SSFA::FindPortals(nodePath, m_pNavMeshPolygon, m_Portals, m_AgentRadius);
+	SSFA::OptimizePortals(m_Portals, path, maxCorners);
+	if (&path != &m_Path)
+		m_Path = path;
+	return true;
+}
+
+bool LocalNavMesh::GetClosestPathPoint(const Vector2& start, const Vector2& goal, Vector2& pathPoint)
+{
+	if (!FindPath(start, goal, m_Path, m_LookaheadCorners) || m_Path.empty() || IsCrossingSkippedHouse(start))
+		return false;
+	pathPoint = m_Path.front();
+	return true;
+}
+
+bool LocalNavMesh::IsKnownHouse(const HouseInfo& house) const
+{
+	const auto isSameHouse{ [&house](const HouseInfo& knownHouse) { return DistanceSquared(knownHouse.Center, house.Center) < 1.f; } };
+	return std::any_of(m_Houses.cbegin(), m_Houses.cend(), isSameHouse)
+		|| std::any_of(m_SkippedHouses.cbegin(), m_SkippedHouses.cend(), isSameHouse);
+}
+
+bool LocalNavMesh::IsValidHole(const HouseInfo& house) const
+{
+	//The triangulation can't handle holes that touch each other or the outer shape, those houses are skipped
+	const Vector2 halfSize{ house.Size / 2.f + Vector2{ m_HoleMargin, m_HoleMargin } * 2.f };
+	const Vector2 halfWorld{ m_World.Dimensions / 2.f };
+	if (abs(house.Center.x - m_World.Center.x) + halfSize.x >= halfWorld.x
+		|| abs(house.Center.y - m_World.Center.y) + halfSize.y >= halfWorld.y)
+		return false;
+
+	for (const HouseInfo& knownHouse : m_Houses)
+	{
+		const Vector2 knownHalfSize{ knownHouse.Size / 2.f + Vector2{ m_HoleMargin, m_HoleMargin } * 2.f };
+		if (abs(house.Center.x - knownHouse.Center.x) < halfSize.x + knownHalfSize.x
+			&& abs(house.Center.y - knownHouse.Center.y) < halfSize.y + knownHalfSize.y)
+			return false;
+	}
+	return true;
+}
+
+bool LocalNavMesh::IsCrossingSkippedHouse(const Vector2& start) const
+{
+	//Slab test of every segment of start + m_Path against the house grown by the margin
+	Vector2 segmentStart{ start };
+	for (const Vector2& segmentEnd : m_Path)
+	{
+		const Vector2 direction{ segmentEnd - segmentStart };
+		for (const HouseInfo& house : m_SkippedHouses)
+		{
+			const Vector2 halfSize{ house.Size / 2.f + Vector2{ m_HoleMargin, m_HoleMargin } };
+			const float origins[2]{ segmentStart.x, segmentStart.y };
+			const float deltas[2]{ direction.x, direction.y };
+			const float mins[2]{ house.Center.x - halfSize.x, house.Center.y - halfSize.y };
+			const float maxs[2]{ house.Center.x + halfSize.x, house.Center.y + halfSize.y };
+			float tMin{ 0.f };
+			float tMax{ 1.f };
+			bool isOutside{ false };
+			for (int axis{}; axis < 2 && !isOutside; ++axis)
+			{
+				if (abs(deltas[axis]) <= FLT_EPSILON)
+				{
+					isOutside = origins[axis] < mins[axis] || origins[axis] > maxs[axis];
+					continue;
+				}
+				const float t1{ (mins[axis] - origins[axis]) / deltas[axis] };
+				const float t2{ (maxs[axis] - origins[axis]) / deltas[axis] };
+				tMin = (std::max)(tMin, (std::min)(t1, t2));
+				tMax = (std::min)(tMax, (std::max)(t1, t2));
+				isOutside = tMin > tMax;
+			}
+			if (!isOutside)
+				return true;
+		}
+		segmentStart = segmentEnd;
+	}
+	return false;
+}
+
+void LocalNavMesh::Build()
+{
+	Release();
+
+	//Outer shape CCW, holes CW
+	const Vector2 halfWorld{ m_World.Dimensions / 2.f };
+	const std::vector<Vector2> outerShape{
+		m_World.Center + Vector2{ -halfWorld.x, -halfWorld.y },
+		m_World.Center + Vector2{ halfWorld.x, -halfWorld.y },
+		m_World.Center + Vector2{ halfWorld.x, halfWorld.y },
+		m_World.Center + Vector2{ -halfWorld.x, halfWorld.y } };
+	m_pNavMeshPolygon = new Polygon(outerShape);
+
+	for (const HouseInfo& house : m_Houses)
+	{
+		const Vector2 halfSize{ house.Size / 2.f + Vector2{ m_HoleMargin, m_HoleMargin } };
+		std::list<Vector2> hole{
+			house.Center + Vector2{ -halfSize.x, -halfSize.y },
+			house.Center + Vector2{ -halfSize.x, halfSize.y },
+			house.Center + Vector2{ halfSize.x, halfSize.y },
+			house.Center + Vector2{ halfSize.x, -halfSize.y } };
+		m_pNavMeshPolygon->AddChild(hole);
+	}
+	m_pNavMeshPolygon->Triangulate();
+
+	//Node in the middle of every line shared by two triangles
+	m_pNavGraph = new NavGraph(false);
+	const std::vector<Line*>& lines{ m_pNavMeshPolygon->GetLines() };
+	m_LineNodeIndices.assign(lines.size(), invalid_node_index);
+	for (const Line* pLine : lines)
+	{
+		if (m_pNavMeshPolygon->GetLineTriangles(pLine->index)[1] == -1)
+			continue;
+		const int nodeIdx{ m_pNavGraph->GetNextFreeNodeIndex() };
+		m_pNavGraph->AddNode(new NavGraphNode(nodeIdx, pLine->index, (pLine->p1 + pLine->p2) / 2.f));
+		m_LineNodeIndices[pLine->index] = nodeIdx;
+	}
+
+	//Connect the nodes of every triangle, the cost is the distance between the line centers
+	for (const Triangle* pTriangle : m_pNavMeshPolygon->GetTriangles())
+	{
+		const std::array<int, 3>& lineIndices{ pTriangle->metaData.IndexLines };
+		for (size_t i{}; i < lineIndices.size(); ++i)
+		{
+			const int from{ m_LineNodeIndices[lineIndices[i]] };
+			const int to{ m_LineNodeIndices[lineIndices[(i + 1) % lineIndices.size()]] };
+			if (from == invalid_node_index || to == invalid_node_index)
+				continue;
+			m_pNavGraph->AddConnection(new GraphConnection2D(from, to, Distance(m_pNavGraph->GetNode(from)->GetPosition(), m_pNavGraph->GetNode(to)->GetPosition())));
+		}
+	}
+
+	m_StartNodeIdx = m_pNavGraph->GetNextFreeNodeIndex();
+	m_pNavGraph->AddNode(new NavGraphNode(m_StartNodeIdx, m_World.Center));
+	m_GoalNodeIdx = m_pNavGraph->GetNextFreeNodeIndex();
+	m_pNavGraph->AddNode(new NavGraphNode(m_GoalNodeIdx, m_World.Center));
+	m_Path.clear();
+}
+
+void LocalNavMesh::Release()
+{
+	SAFE_DELETE(m_pNavGraph);
+	SAFE_DELETE(m_pNavMeshPolygon);
+	m_LineNodeIndices.clear();
+	m_StartNodeIdx = invalid_node_index;
+	m_GoalNodeIdx = invalid_node_index;
+	m_pStartTriangle = nullptr;
+	m_pGoalTriangle = nullptr;
+}
+
+void LocalNavMesh::ConnectToTriangle(int nodeIdx, const Triangle* pTriangle)
+{
+	for (const int lineIdx : pTriangle->metaData.IndexLines)
+	{
+		const int lineNodeIdx{ m_LineNodeIndices[lineIdx] };
+		if (lineNodeIdx == invalid_node_index)
+			continue;
+		m_pNavGraph->AddConnection(new GraphConnection2D(nodeIdx, lineNodeIdx, Distance(m_pNavGraph->GetNode(nodeIdx)->GetPosition(), m_pNavGraph->GetNode(lineNodeIdx)->GetPosition())));
+	}
+}
@@ -0,0 +1,91 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// LocalNavMesh.h: Navigation mesh built by the plugin itself. The world bounds are the outer shape,
+// every perceived house is a hole. The triangulation gives a graph with a node on every shared edge,
+// paths are found with A* over that graph and smoothed with the funnel algorithm (SSFA).
+// Houses that touch the border or another hole can't be triangulated, they are kept aside and
+// a path that crosses one of them is refused so the caller asks the host instead.
+// Houses not perceived yet are unknown; the agent faces where it walks, so a house on the way is
+// perceived before it is reached and the Update that adds it tells the caller to drop its paths.
+/*=============================================================================*/
+#ifndef ELITE_LOCAL_NAVMESH
+#define ELITE_LOCAL_NAVMESH
+
+//-----------------------------------------------------------------
+// Includes & Forward Declarations
+//-----------------------------------------------------------------
+#include "Exam_HelperStructs.h"
+#include "EGeometry2DTypes.h"
+#include "EGraph2D.h"
+#include "EPathSmoothing.h"
+
+//=== Options ===
+#define USE_LOCAL_NAVMESH //NavigationCache answers from the local navmesh, the host is asked off the mesh and around skipped houses
+
+class LocalNavMesh final
+{
+public:
+	LocalNavMesh() = default;
+	~LocalNavMesh();
+
+	LocalNavMesh(const LocalNavMesh&) = delete;
+	LocalNavMesh& operator=(const LocalNavMesh&) = delete;
+
+	//Adds the houses that weren't seen yet and rebuilds when one became a hole,
+	//returns true when a house was added (as hole or skipped) so earlier paths may cross it
+	bool Update(const WorldInfo& world, const std::vector<HouseInfo>& houses);
+
+	//Path without the start position, ending at goal. False when start or goal is off the mesh or unreachable.
+	//With maxCorners the path stops after that many points, the rest of the funnel isn't evaluated
+	bool FindPath(const Elite::Vector2& start, const Elite::Vector2& goal, std::vector<Elite::Vector2>& path,
+		size_t maxCorners = (std::numeric_limits<size_t>::max)());
+	//First point of FindPath, what NavMesh_GetClosestPathPoint would return.
+	//False as well when the path (up to the lookahead corners) crosses a skipped house
+	bool GetClosestPathPoint(const Elite::Vector2& start, const Elite::Vector2& goal, Elite::Vector2& pathPoint);
+
+	//Houses are grown by the margin so paths don't graze the walls
+	void SetHoleMargin(float margin) { m_HoleMargin = margin; }
+	//Portals are shrunk by the radius, on top of the hole margin
+	void SetAgentRadius(float radius) { m_AgentRadius = radius; }
+	//Corners GetClosestPathPoint keeps in GetPath for lookahead
+	void SetLookaheadCorners(size_t corners) { m_LookaheadCorners = (std::max)(corners, size_t(1)); }
+
+	bool IsBuilt() const { return m_pNavMeshPolygon != nullptr; }
+	const Elite::Polygon* GetPolygon() const { return m_pNavMeshPolygon; }
+	const std::vector<HouseInfo>& GetHouses() const { return m_Houses; }
+	const std::vector<HouseInfo>& GetSkippedHouses() const { return m_SkippedHouses; }
+	//Last path found (up to the lookahead corners for GetClosestPathPoint), reused without a new query
+	const std::vector<Elite::Vector2>& GetPath() const { return m_Path; }
+
+private:
+	using NavGraph = Elite::Graph2D<Elite::NavGraphNode, Elite::GraphConnection2D>;
+
+	WorldInfo m_World{};
+	std::vector<HouseInfo> m_Houses{};
+	std::vector<HouseInfo> m_SkippedHouses{}; //Perceived, but not a hole in the mesh
+	float m_HoleMargin = 1.f;
+	float m_AgentRadius = 0.f;
+	size_t m_LookaheadCorners = 3;
+
+	Elite::Polygon* m_pNavMeshPolygon = nullptr;
+	NavGraph* m_pNavGraph = nullptr;
+	//Start and goal are two extra nodes, only their connections change per query
+	int m_StartNodeIdx = invalid_node_index;
+	int m_GoalNodeIdx = invalid_node_index;
+	std::vector<int> m_LineNodeIndices{}; //Node on every line, invalid_node_index for the edges of the mesh
+
+	std::vector<Elite::Portal> m_Portals{}; //Reused by every query
+	std::vector<Elite::Vector2> m_Path{};
+	//Triangles of the last query, start and goal move little between queries so the lookup walks from there
+	const Elite::Triangle* m_pStartTriangle = nullptr;
+	const Elite::Triangle* m_pGoalTriangle = nullptr;
+
+	bool IsKnownHouse(const HouseInfo& house) const;
+	bool IsValidHole(const HouseInfo& house) const;
+	bool IsCrossingSkippedHouse(const Elite::Vector2& start) const;
+	void Build();
+	void Release();
+	void ConnectToTriangle(int nodeIdx, const Elite::Triangle* pTriangle);
+};
+#endif
@@ -0,0 +1,84 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "NavigationCache.h"
+#include "IExamInterface.h"
+
+Elite::Vector2 NavigationCache::GetClosestPathPoint(IExamInterface* pInterface, const Elite::Vector2& agentPosition, const Elite::Vector2& target)
+{
+	const int agentCellX{ ToCell(agentPosition.x) };
+	const int agentCellY{ ToCell(agentPosition.y) };
+	const int targetCellX{ ToCell(target.x) };
+	const int targetCellY{ ToCell(target.y) };
+
+	const unsigned int hash{ static_cast<unsigned int>(agentCellX) * 73856093u ^ static_cast<unsigned int>(agentCellY) * 19349663u
+		^ static_cast<unsigned int>(targetCellX) * 83492791u ^ static_cast<unsigned int>(targetCellY) * 50331653u };
+	Entry& entry{ m_Entries[hash % m_EntryCount] };
+
+	const bool isSameCells{ entry.IsValid
+		&& entry.AgentCellX == agentCellX && entry.AgentCellY == agentCellY
+		&& entry.TargetCellX == targetCellX && entry.TargetCellY == targetCellY };
+	//Once the agent is at the path point the host would give the next one
+	const bool isReached{ Elite::DistanceSquared(agentPosition, entry.PathPoint) <= m_CellSize * m_CellSize };
+	if (isSameCells && (entry.IsDirect || !isReached))
+	{
+		++m_CacheHits;
+		return entry.IsDirect ? target : entry.PathPoint;
+	}
+
+	Elite::Vector2 pathPoint{};
+	bool isOnNavMesh{ false };
+#ifdef USE_LOCAL_NAVMESH
+	isOnNavMesh = m_NavMesh.GetClosestPathPoint(agentPosition, target, pathPoint);
+#endif
+	if (isOnNavMesh)
+	{
+		++m_MeshQueries;
+	}
+	else
+	{
+		++m_HostQueries;
+		pathPoint = pInterface->NavMesh_GetClosestPathPoint(target);
+	}
+	entry.AgentCellX = agentCellX;
+	entry.AgentCellY = agentCellY;
+	entry.TargetCellX = targetCellX;
+	entry.TargetCellY = targetCellY;
+	entry.PathPoint = pathPoint;
+	entry.IsDirect = pathPoint == target;
+	entry.IsValid = true;
+
+	AddToCorridor(targetCellX, targetCellY, pathPoint);
+	return pathPoint;
+}
+
+void NavigationCache::Clear()
+{
+	m_Entries.fill(Entry{});
+	m_Corridor.clear();
+}
+
+#ifdef USE_LOCAL_NAVMESH
+void NavigationCache::UpdateNavMesh(const WorldInfo& world, const std::vector<HouseInfo>& houses)
+{
+	if (m_NavMesh.Update(world, houses))
+		Clear();
+}
+#endif
+
+void NavigationCache::AddToCorridor(int targetCellX, int targetCellY, const Elite::Vector2& pathPoint)
+{
+	if (targetCellX != m_CorridorTargetCellX || targetCellY != m_CorridorTargetCellY)
+	{
+		m_Corridor.clear();
+		m_CorridorTargetCellX = targetCellX;
+		m_CorridorTargetCellY = targetCellY;
+	}
+
+	if (!m_Corridor.empty() && Elite::DistanceSquared(m_Corridor.back(), pathPoint) <= m_CellSize * m_CellSize)
+		return;
+	if (m_Corridor.size() >= m_MaxCorridorSize)
+		m_Corridor.erase(m_Corridor.begin());
+	m_Corridor.push_back(pathPoint);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "LocalNavMesh.h"
+#include <array>
+
+class IExamInterface;
+
+//Memoizes NavMesh_GetClosestPathPoint per (agent cell, target cell).
+//With USE_LOCAL_NAVMESH a miss is answered by the local navmesh first, the host when it's off the mesh
+//or the local path crosses a house the mesh couldn't take as a hole.
+//An entry is reused while the agent and the target stay in their cells and the agent hasn't reached the returned point yet.
+//Path points returned while seeking the same target cell are kept as the corridor walked so far.
+class NavigationCache final
+{
+public:
+	NavigationCache() = default;
+	~NavigationCache() = default;
+
+	Elite::Vector2 GetClosestPathPoint(IExamInterface* pInterface, const Elite::Vector2& agentPosition, const Elite::Vector2& target);
+	void Clear();
+
+#ifdef USE_LOCAL_NAVMESH
+	//Adds the houses not seen yet to the local navmesh, any new house invalidates the cached path points
+	void UpdateNavMesh(const WorldInfo& world, const std::vector<HouseInfo>& houses);
+	const LocalNavMesh& GetNavMesh() const { return m_NavMesh; }
+#endif
+
+	//Movement smaller than a cell doesn't trigger a new host query
+	void SetCellSize(float cellSize) { m_CellSize = cellSize; Clear(); }
+	float GetCellSize() const { return m_CellSize; }
+
+	//Host only returns the next point, so this is the part of the path seen so far, in order
+	const std::vector<Elite::Vector2>& GetCorridor() const { return m_Corridor; }
+
+	unsigned int GetHostQueries() const { return m_HostQueries; }
+	unsigned int GetMeshQueries() const { return m_MeshQueries; }
+	unsigned int GetCacheHits() const { return m_CacheHits; }
+
+private:
+	struct Entry
+	{
+		int AgentCellX = 0;
+		int AgentCellY = 0;
+		int TargetCellX = 0;
+		int TargetCellY = 0;
+		Elite::Vector2 PathPoint = {};
+		bool IsDirect = false; //Host returned the target itself, nothing is in the way
+		bool IsValid = false;
+	};
+
+	static constexpr size_t m_EntryCount = 64; //Direct mapped, a collision just overwrites
+	static constexpr size_t m_MaxCorridorSize = 32;
+
+	std::array<Entry, m_EntryCount> m_Entries{};
+	float m_CellSize = 2.f;
+
+	std::vector<Elite::Vector2> m_Corridor = {};
+	int m_CorridorTargetCellX = 0;
+	int m_CorridorTargetCellY = 0;
+
+#ifdef USE_LOCAL_NAVMESH
+	LocalNavMesh m_NavMesh{};
+#endif
+
+	unsigned int m_HostQueries = 0;
+	unsigned int m_MeshQueries = 0;
+	unsigned int m_CacheHits = 0;
+
+	int ToCell(float coordinate) const { return static_cast<int>(floorf(coordinate / m_CellSize)); }
+	void AddToCorridor(int targetCellX, int targetCellY, const Elite::Vector2& pathPoint);
+};
@@ -0,0 +1,209 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "OrcaAvoidance.h"
+
+Elite::Vector2 OrcaAvoidance::ComputeSafeVelocity(const AgentInfo& agent, const PerceptionBuffers& perception, const Elite::Vector2& preferredVelocity, float deltaT)
+{
+	using namespace Elite;
+	m_Lines.clear();
+
+	const float invTimeHorizon{ 1.f / m_TimeHorizon };
+	const float maxSpeed{ agent.MaxLinearSpeed };
+	//Enemies that can't be reached within the time horizon don't constrain anything
+	const float neighborRange{ maxSpeed * m_TimeHorizon };
+
+	for (size_t i{}; i < perception.Enemies.size(); ++i)
+	{
+		const EnemyInfo& enemy{ perception.Enemies[i] };
+		const Vector2 relativePosition{ perception.EnemyPositionsX[i] - agent.Position.x, perception.EnemyPositionsY[i] - agent.Position.y };
+		const Vector2 relativeVelocity{ agent.LinearVelocity - enemy.LinearVelocity };
+		const float distanceSquared{ relativePosition.SqrtMagnitude() };
+		const float combinedRadius{ (agent.AgentSize + enemy.Size) / 2.f + m_SafetyMargin };
+		const float combinedRadiusSquared{ combinedRadius * combinedRadius };
+		const float rangeSquared{ (neighborRange + combinedRadius) * (neighborRange + combinedRadius) };
+		if (distanceSquared > rangeSquared)
+			continue;
+
+		OrcaLine line{};
+		Vector2 u{};
+		if (distanceSquared > combinedRadiusSquared)
+		{
+			//No collision, vector from cutoff center to relative velocity
+			const Vector2 w{ relativeVelocity - invTimeHorizon * relativePosition };
+			const float wLengthSquared{ w.SqrtMagnitude() };
+			const float dotProduct1{ Dot(w, relativePosition) };
+
+			if (dotProduct1 < 0.f && dotProduct1 * dotProduct1 > combinedRadiusSquared * wLengthSquared)
+			{
+				//Project on cutoff circle
+				const float wLength{ sqrtf(wLengthSquared) };
+				const Vector2 unitW{ w / wLength };
+				line.Direction = Vector2{ unitW.y, -unitW.x };
+				u = (combinedRadius * invTimeHorizon - wLength) * unitW;
+			}
+			else
+			{
+				//Project on legs
+				const float leg{ sqrtf(distanceSquared - combinedRadiusSquared) };
+				if (Cross(relativePosition, w) > 0.f)
+				{
+					//Left leg
+					line.Direction = Vector2{ relativePosition.x * leg - relativePosition.y * combinedRadius, relativePosition.x * combinedRadius + relativePosition.y * leg } / distanceSquared;
+				}
+				else
+				{
+					//Right leg
+					line.Direction = -1.f * Vector2{ relativePosition.x * leg + relativePosition.y * combinedRadius, -relativePosition.x * combinedRadius + relativePosition.y * leg } / distanceSquared;
+				}
+				const float dotProduct2{ Dot(relativeVelocity, line.Direction) };
+				u = dotProduct2 * line.Direction - relativeVelocity;
+			}
+		}
+		else
+		{
+			//Collision, project on cut-off circle of this time step
+			const float invTimeStep{ 1.f / (std::max)(deltaT, 1e-4f) };
+			const Vector2 w{ relativeVelocity - invTimeStep * relativePosition };
+			const float wLength{ w.Magnitude() };
+			if (wLength <= 0.f)
+				continue;
+			const Vector2 unitW{ w / wLength };
+			line.Direction = Vector2{ unitW.y, -unitW.x };
+			u = (combinedRadius * invTimeStep - wLength) * unitW;
+		}
+
+		line.Point = agent.LinearVelocity + m_Responsibility * u;
+		m_Lines.push_back(line);
+	}
+
+	if (m_Lines.empty())
+		return preferredVelocity;
+
+	Vector2 result{};
+	const size_t lineFail{ LinearProgram2(m_Lines, maxSpeed, preferredVelocity, false, result) };
+	if (lineFail < m_Lines.size())
+		LinearProgram3(lineFail, maxSpeed, result);
+	return result;
+}
+
+#pragma region LINEAR PROGRAMS
+//Optimizes on line lineNo, constrained by the lines before it and the max speed circle
+bool OrcaAvoidance::LinearProgram1(const std::vector<OrcaLine>& lines, size_t lineNo, float radius, const Elite::Vector2& optVelocity, bool directionOpt, Elite::Vector2& result)
+{
+	using namespace Elite;
+	const OrcaLine& line{ lines[lineNo] };
+	const float dotProduct{ Dot(line.Point, line.Direction) };
+	const float discriminant{ dotProduct * dotProduct + radius * radius - line.Point.SqrtMagnitude() };
+	if (discriminant < 0.f)
+		return false; //Max speed circle fully invalidates line lineNo
+
+	const float sqrtDiscriminant{ sqrtf(discriminant) };
+	float tLeft{ -dotProduct - sqrtDiscriminant };
+	float tRight{ -dotProduct + sqrtDiscriminant };
+
+	for (size_t i{}; i < lineNo; ++i)
+	{
+		const float denominator{ Cross(line.Direction, lines[i].Direction) };
+		const float numerator{ Cross(lines[i].Direction, line.Point - lines[i].Point) };
+
+		if (abs(denominator) <= FLT_EPSILON)
+		{
+			//Lines are (almost) parallel
+			if (numerator < 0.f)
+				return false;
+			continue;
+		}
+
+		const float t{ numerator / denominator };
+		if (denominator >= 0.f)
+			tRight = (std::min)(tRight, t); //Line i bounds line lineNo on the right
+		else
+			tLeft = (std::max)(tLeft, t); //Line i bounds line lineNo on the left
+
+		if (tLeft > tRight)
+			return false;
+	}
+
+	if (directionOpt)
+	{
+		//Optimize direction
+		result = Dot(optVelocity, line.Direction) > 0.f ? line.Point + tRight * line.Direction : line.Point + tLeft * line.Direction;
+	}
+	else
+	{
+		//Optimize closest point
+		const float t{ Dot(line.Direction, optVelocity - line.Point) };
+		result = line.Point + Clamp(t, tLeft, tRight) * line.Direction;
+	}
+	return true;
+}
+
+//Returns the index of the first line that couldn't be satisfied, lines.size() on success
+size_t OrcaAvoidance::LinearProgram2(const std::vector<OrcaLine>& lines, float radius, const Elite::Vector2& optVelocity, bool directionOpt, Elite::Vector2& result)
+{
+	using namespace Elite;
+	if (directionOpt)
+		result = optVelocity * radius; //optVelocity is a unit vector here
+	else if (optVelocity.SqrtMagnitude() > radius * radius)
+		result = optVelocity.GetNormalized() * radius;
+	else
+		result = optVelocity;
+
+	for (size_t i{}; i < lines.size(); ++i)
+	{
+		if (Cross(lines[i].Direction, lines[i].Point - result) > 0.f)
+		{
+			//Result violates constraint i, the new optimum lies on line i
+			const Vector2 tempResult{ result };
+			if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+			{
+				result = tempResult;
+				return i;
+			}
+		}
+	}
+	return lines.size();
+}
+
+//Infeasible: minimizes the largest penetration into the violated half-planes instead
+void OrcaAvoidance::LinearProgram3(size_t beginLine, float radius, Elite::Vector2& result)
+{
+	using namespace Elite;
+	float distance{};
+
+	for (size_t i{ beginLine }; i < m_Lines.size(); ++i)
+	{
+		if (Cross(m_Lines[i].Direction, m_Lines[i].Point - result) <= distance)
+			continue; //Result already satisfies constraint i within the current distance
+
+		m_ProjectedLines.clear();
+		for (size_t j{}; j < i; ++j)
+		{
+			OrcaLine line{};
+			const float determinant{ Cross(m_Lines[i].Direction, m_Lines[j].Direction) };
+			if (abs(determinant) <= FLT_EPSILON)
+			{
+				//Parallel lines
+				if (Dot(m_Lines[i].Direction, m_Lines[j].Direction) > 0.f)
+					continue; //Same direction
+				line.Point = 0.5f * (m_Lines[i].Point + m_Lines[j].Point); //Opposite direction
+			}
+			else
+				line.Point = m_Lines[i].Point + (Cross(m_Lines[j].Direction, m_Lines[i].Point - m_Lines[j].Point) / determinant) * m_Lines[i].Direction;
+
+			line.Direction = (m_Lines[j].Direction - m_Lines[i].Direction).GetNormalized();
+			m_ProjectedLines.push_back(line);
+		}
+
+		const Vector2 tempResult{ result };
+		if (LinearProgram2(m_ProjectedLines, radius, Vector2{ -m_Lines[i].Direction.y, m_Lines[i].Direction.x }, true, result) < m_ProjectedLines.size())
+		{
+			//Can only fail because of floating point errors, keep the previous result
+			result = tempResult;
+		}
+		distance = Cross(m_Lines[i].Direction, m_Lines[i].Point - result);
+	}
+}
+#pragma endregion
@@ -0,0 +1,56 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// OrcaAvoidance.h: Local avoidance of moving enemies with optimal reciprocal collision avoidance (ORCA).
+// Every perceived enemy becomes a half-plane of allowed velocities, the velocity closest to the
+// preferred one inside all half-planes is found with a 2D linear program (as in RVO2).
+/*=============================================================================*/
+#ifndef ELITE_ORCA_AVOIDANCE
+#define ELITE_ORCA_AVOIDANCE
+
+//-----------------------------------------------------------------
+// Includes & Forward Declarations
+//-----------------------------------------------------------------
+#include "Exam_HelperStructs.h"
+#include "FrameSnapshot.h"
+
+//=== Options ===
+#define USE_ORCA_AVOIDANCE //Plugin corrects the final steering velocity with OrcaAvoidance
+
+//Allowed velocities lie left of the line (Point + t * Direction), Direction is normalized
+struct OrcaLine
+{
+	Elite::Vector2 Point = {};
+	Elite::Vector2 Direction = {};
+};
+
+class OrcaAvoidance final
+{
+public:
+	OrcaAvoidance() = default;
+	~OrcaAvoidance() = default;
+
+	//Closest velocity to preferredVelocity that doesn't collide with an enemy within the time horizon (or gets out of a collision)
+	Elite::Vector2 ComputeSafeVelocity(const AgentInfo& agent, const PerceptionBuffers& perception, const Elite::Vector2& preferredVelocity, float deltaT);
+
+	void SetTimeHorizon(float timeHorizon) { m_TimeHorizon = timeHorizon; }
+	void SetSafetyMargin(float margin) { m_SafetyMargin = margin; }
+	//Share of the avoidance the agent takes on, 1 because the enemies don't avoid the agent (0.5 would be reciprocal)
+	void SetResponsibility(float responsibility) { m_Responsibility = responsibility; }
+
+	const std::vector<OrcaLine>& GetLines() const { return m_Lines; }
+
+private:
+	float m_TimeHorizon = 2.f;
+	float m_SafetyMargin = 1.f;
+	float m_Responsibility = 1.f;
+
+	//Reused every tick
+	std::vector<OrcaLine> m_Lines = {};
+	std::vector<OrcaLine> m_ProjectedLines = {};
+
+	static bool LinearProgram1(const std::vector<OrcaLine>& lines, size_t lineNo, float radius, const Elite::Vector2& optVelocity, bool directionOpt, Elite::Vector2& result);
+	static size_t LinearProgram2(const std::vector<OrcaLine>& lines, float radius, const Elite::Vector2& optVelocity, bool directionOpt, Elite::Vector2& result);
+	void LinearProgram3(size_t beginLine, float radius, Elite::Vector2& result);
+};
+#endif
@@ -2,14 +2,11 @@
 #include "Plugin.h"
 #include "IExamInterface.h"
 #include "EBehaviorTree.h"
+#include "EFlatBehaviorTree.h"
 #include "Behaviors.h"
 
 Plugin::~Plugin()
 {
-	for (auto behaviorIt : m_pBehaviors)
-	{
-		SAFE_DELETE(behaviorIt.second);
-	}
 	SAFE_DELETE(m_pBT);
 
 	
@@ -29,7 +26,6 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 	info.Student_LastName = "Caerels";
 	info.Student_Class = "2DAE02";
 
-	InitGrid(100);
 	InitBlackboard();
 	InitBehavior();
 
@@ -108,15 +104,15 @@ void Plugin::Update(float dt)
 //This function calculates the new SteeringOutput, called once per frame
 SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 {
-	HandleTimers(dt);
-	
 	//Use the Interface (IAssignmentInterface) to 'interface' with the AI_Framework
-	m_pB->ChangeData("Agent", &m_pInterface->Agent_GetInfo());
+	m_Frame.Update(m_pInterface);
+	m_pB->MarkChanged("Agent"); //Points into the snapshot, only the content changed
 
 	//auto nextTargetPos = m_Target; //To start you can use the mouse position as guidance
 
 	//--------------AREA HANDLING--------------
 	HandleHouses();
+	HandleExploration(dt);
 	HandleEntities();
 	HandleItemManagement();
 	//-----------------------------------------
@@ -136,62 +132,22 @@ void Plugin::Render(float dt) const
 	m_pInterface->Draw_SolidCircle(m_Target, .7f, { 0,0 }, { 1, 0, 0 });
 }
 
-vector<HouseInfo> Plugin::GetHousesInFOV() const
-{
-	vector<HouseInfo> vHousesInFOV = {};
-
-	HouseInfo hi = {};
-	for (int i = 0;; ++i)
-	{
-		if (m_pInterface->Fov_GetHouseByIndex(i, hi))
-		{
-			vHousesInFOV.push_back(hi);
-			continue;
-		}
-
-		break;
-	}
-
-	return vHousesInFOV;
-}
-
-vector<EntityInfo> Plugin::GetEntitiesInFOV() const
-{
-	vector<EntityInfo> vEntitiesInFOV = {};
-
-	EntityInfo ei = {};
-	for (int i = 0;; ++i)
-	{
-		if (m_pInterface->Fov_GetEntityByIndex(i, ei))
-		{
-			vEntitiesInFOV.push_back(ei);
-			continue;
-		}
-
-		break;
-	}
-
-	return vEntitiesInFOV;
-}
-
-
-
 void Plugin::InitBlackboard()
 {
 	m_pB = new Blackboard();
 	//Change behaviors and general data accessing
-	m_pB->AddData("Behavior", std::string{"Wander"});
+	m_pB->AddData("Behavior", SteeringType::Wander);
 	m_pB->AddData("pInterface", m_pInterface);
-	m_pB->AddData("Agent", &m_pInterface->Agent_GetInfo()); //is now obsolete, can delete/refactor some code
-	m_pB->AddData("Enemies", std::vector<EnemyInfo*>());
+	m_pB->AddData("Frame", static_cast<const FrameSnapshot*>(&m_Frame));
+	m_pB->AddData("Agent", &m_Frame.GetAgent()); //Stable pointer into the snapshot
+	m_pB->AddData("Perception", static_cast<const PerceptionBuffers*>(nullptr)); //Enemies, items and purge zones in FOV
 	m_pB->AddData("Target", Vector2{0,0});
-	m_pB->AddData("PurgeZones", std::vector<PurgeZoneInfo*>());
 	m_pB->AddData("CloseToBorder", bool{});
+	//Set by a conditional, cleared once the BehaviorTimeLimit of their branch runs out
 	m_pB->AddData("Turning", bool{});
-	m_pB->AddData("WanderTimer", float{});
-	m_pB->AddData("Cooldown", &m_Cooldown);
+	m_pB->AddData("Wandering", bool{});
 	//Grid
-	m_pB->AddData("Waypoints", &m_pWayPoints);
+	m_pB->AddData("Exploration", &m_Exploration);
 
 
 	//Houses
@@ -206,86 +162,25 @@ void Plugin::InitBlackboard()
 	m_pB->AddData("GoingInside", bool{});
 
 	//ItemManagement
-	m_pB->AddData("Items", std::vector<std::pair<EntityInfo, ItemInfo*>>());
-	m_pB->AddData("Inventory", &m_pInventory);
+	m_pB->AddData("Inventory", &m_Inventory);
+	m_pB->AddData("InventoryOptimizer", &m_InventoryOptimizer);
 	m_pB->AddData("WantedType", eItemType{});
 }
 
-void Plugin::InitGrid(int cellSize)
+void Plugin::HandleExploration(const float dt)
 {
-	int worldWidth{ int(m_pInterface->World_GetInfo().Dimensions.x) };
-	int worldHeight{ int(m_pInterface->World_GetInfo().Dimensions.y) };
-
-	m_Cols = worldWidth / cellSize;
-	m_Rows = worldHeight / cellSize;
-
-	Vector2 currPoint{ m_pInterface->World_GetInfo().Center.x - worldWidth/2, m_pInterface->World_GetInfo().Center.y - worldHeight/2 };
-
-
-	for (int i{}; i < m_Rows; i++)
-	{
-		for (int j{}; j < m_Cols; j++)
-		{
-			Vector2 waypoint{ currPoint.x + (cellSize * j + cellSize / 2.f), currPoint.y + (i *cellSize+cellSize/2.f) };
-			m_pWayPoints[ i * m_Cols + j] = std::pair<bool, Vector2>{ false,waypoint };
-		}
-	}
+	//The cells follow the FOV range, so the grid is set up on the first tick the agent is known
+	const AgentInfo& agent{ m_Frame.GetAgent() };
+	if (m_Exploration.GetCellCount() == 0)
+		m_Exploration.Initialize(m_Frame.GetWorld(), agent.FOV_Range);
+	m_Exploration.Update(agent, dt);
 }
 
 void Plugin::HandleEntities()
 {
-	std::vector<std::pair<EntityInfo, ItemInfo*>> pItemsInSight{};
-	std::vector<EnemyInfo*> pEnemiesInSight{};
-	std::vector<PurgeZoneInfo*> pPurgeZonesInSight{};
-	auto vEntitiesInFOV = GetEntitiesInFOV(); //uses m_pInterface->Fov_GetEntityByIndex(...)
-	for (auto& e : vEntitiesInFOV)
-	{
-		switch (e.Type)
-		{
-		case	eEntityType::ENEMY:
-			HandleEnemy(e, pEnemiesInSight);
-			break;
-		case eEntityType::ITEM:
-			HandleItem(e, pItemsInSight);
-			break;
-		case eEntityType::PURGEZONE:
-			HandlePurgeZone(e, pPurgeZonesInSight);
-			break;
-		default:
-			break;
-		}
-	}
-
-	//UPDATE Bb
-	m_pB->ChangeData("Items", pItemsInSight);
-	m_pB->ChangeData("Enemies", pEnemiesInSight);
-	m_pB->ChangeData("PurgeZones", pPurgeZonesInSight);
-
-
-}
-
-void Plugin::HandleEnemy(const EntityInfo& eInfo, std::vector<EnemyInfo*>& pEnemiesInSight)
-{
-	pEnemiesInSight.push_back(new EnemyInfo());
-	m_pInterface->Enemy_GetInfo(eInfo, *pEnemiesInSight.back());
-}
-
-void Plugin::HandleItem(EntityInfo& eInfo, std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInSight)
-{
-	
-	ItemInfo pItemInfo{};
-	m_pInterface->Item_GetInfo(eInfo, pItemInfo);
-	//std::cout << "Item:" << eInfo.Location.x << ", " << eInfo.Location.y << "---Type: " << " ---EntityHash: " << eInfo.EntityHash << std::endl;
-	pItemsInSight.push_back(std::pair<EntityInfo, ItemInfo*>(eInfo, new ItemInfo(pItemInfo)));
-
-}
-
-void Plugin::HandlePurgeZone(const EntityInfo& eInfo, std::vector<PurgeZoneInfo*>& pPurgeZones)
-{
-	pPurgeZones.push_back(new PurgeZoneInfo());
-	m_pInterface->PurgeZone_GetInfo(eInfo, *pPurgeZones.back());
-	pPurgeZones.back()->Radius += 10;
-	//std::cout << "Purge Zone in FOV:" << eInfo.Location.x << ", " << eInfo.Location.y << " ---EntityHash: " << eInfo.EntityHash << "---Radius: " << zoneInfo.Radius << std::endl;
+	//Enemies, items and purge zones are sorted into the snapshot's reusable buffers in one sweep,
+	//the pointer is the same every tick so only the version needs to change
+	m_pB->ChangeData("Perception", &m_Frame.GetPerception());
 }
 
 void Plugin::HandleItemManagement()
@@ -300,7 +195,7 @@ void Plugin::HandleItemManagement()
 		//Keep in mind that DebugParams are only used for debugging purposes, by default this flag is FALSE
 		//Otherwise, use GetEntitiesInFOV() to retrieve a vector of all entities in the FOV (EntityInfo)
 		//Item_Grab gives you the ItemInfo back, based on the passed EntityHash (retrieved by GetEntitiesInFOV)
-		if (m_pInterface->Item_Grab(GetEntitiesInFOV()[0], item))
+		if (!m_Frame.GetEntitiesInFOV().empty() && m_pInterface->Item_Grab(m_Frame.GetEntitiesInFOV()[0], item))
 		{
 			//Once grabbed, you can add it to a specific inventory slot
 			//Slot must be empty
@@ -327,79 +222,64 @@ void Plugin::HandleItemManagement()
 
 void Plugin::DebugGrid()
 {
-	for (size_t i{}; i < m_pWayPoints.size(); i++)
+	//The grid starts over by itself once explored (ExplorationPlanner::GetNextCell)
+	for (int i{}; i < m_Exploration.GetCellCount(); i++)
 	{
-		if(!m_pWayPoints.at(i).first)
-			m_pInterface->Draw_Point(m_pWayPoints.at(i).second, 3, Vector3{ 1,0,0 });
-		else 
-			m_pInterface->Draw_Point(m_pWayPoints.at(i).second, 3, Vector3{ 0,1,0 });
-	}
-
-	//GridReset
-	size_t counter{};
-	for (size_t i{}; i < m_pWayPoints.size(); i++)
-	{
-		if (m_pWayPoints.at(i).first)
-			counter++;
-
-	}
-	if (counter >= m_pWayPoints.size()-1)
-	{
-		for (size_t i{}; i < m_pWayPoints.size(); i++)
-		{
-			m_pWayPoints.at(i).first = false;
-		}
+		if (!m_Exploration.IsVisited(i))
+			m_pInterface->Draw_Point(m_Exploration.GetCellCenter(i), 3, Vector3{ 1,0,0 });
+		else
+			m_pInterface->Draw_Point(m_Exploration.GetCellCenter(i), 3, Vector3{ 0,1,0 });
 	}
 }
 
 void Plugin::InitBehavior()
 {
-
-	for (size_t i{ 0 }; i < m_pInterface->Inventory_GetCapacity(); i++)
-	{
-		m_pInventory[static_cast<unsigned char>(i)] = nullptr;
-	}
-
-	m_pBehaviors["Seek"] = new Seek();
-	m_pBehaviors["Wander"] = new Wander();
-	m_pBehaviors["Face"] = new Face();
-	m_pBehaviors["Evade"] = new Evade();
-	m_pBehaviors["FaceSeek"] = new FaceSeek();
+	m_Inventory.Initialize(m_pInterface);
+
+	m_Steering.SetBehavior(SteeringType::AvoidPurgeZone, new AvoidPurgeZone());
+	m_Steering.SetBehavior(SteeringType::AvoidBorder, new AvoidBorder());
+	m_Steering.SetBehavior(SteeringType::Seek, new Seek());
+	m_Steering.SetBehavior(SteeringType::Wander, new Wander());
+	m_Steering.SetBehavior(SteeringType::Face, new Face());
+	m_Steering.SetBehavior(SteeringType::Evade, new Evade());
+	m_Steering.SetBehavior(SteeringType::FaceSeek, new FaceSeek());
+	m_Steering.SetBehavior(SteeringType::Context, new ContextSteering());
+	//Layers always run, they only steer when the agent is about to walk into a purge zone or the border
+	m_Steering.SetEnabled(SteeringType::AvoidPurgeZone, true);
+	m_Steering.SetEnabled(SteeringType::AvoidBorder, true);
+	m_Steering.SetEnabled(m_ActiveSteering, true);
+	m_Steering.SetCombination(SteeringCombination::Priority);
 	
-	m_pBT = new BehaviorTree(m_pB,
+	IBehavior* pRoot =
 		new BehaviorSelector(
 			{
 				new BehaviorSequence(
 				{
-						new BehaviorConditional(HasGarbage),
+						new BehaviorConditional(HasGarbage, { "Inventory" }),
 						new BehaviorAction(DestroyGarbage),
 				}),
-				new BehaviorSequence(
-				{
-						new BehaviorConditional(HasGun),
-						new BehaviorConditional(IsAimingAtEnemy),
-						new BehaviorAction(Shoot),
-				}),
-				new BehaviorSequence(
-				{
-						//Hasgun 1st, less calculations used if has no gun
-						new BehaviorConditional(HasGun),
-						new BehaviorConditional(IsInDanger),
-						new BehaviorAction(AimAtEnemy),
-					}),
-				new BehaviorSelector(
+				//Survival, scored on one read of the inputs per tick, the best scoring branch that succeeds wins
+				new BehaviorUtilitySelector(
+					{ GetEnergyInput, GetHealthInput, GetClosestEnemyDistanceInput, GetAmmoInput,
+						GetPurgeZoneDistanceInput, GetItemsInFOVInput, GetFoodCountInput, GetMedkitCountInput },
 					{
-						new BehaviorSequence
-						({
-							new BehaviorConditional(IsInHouse),
-							new BehaviorConditional(IsCloseToPurgeZone),
-							new BehaviorAction(EscapePurgeZone),
-						}),
-						new BehaviorSequence
-						({
-							new BehaviorConditional(IsCloseToPurgeZone),
-							new BehaviorAction(EscapePurgeZone),
-						}),
+						//Leaving a purge zone beats everything once its edge is close
+						{ new BehaviorAction(EscapePurgeZone), { { 4, 0.f, 20.f, -1.f, 1.f } }, 2.f },
+						//Shoot and aim scale with how close the enemy is, no ammo scores 0
+						{
+							new BehaviorSequence(
+							{
+								new BehaviorConditional(IsAimingAtEnemy, { "Agent", "Perception", "Frame" }),
+								new BehaviorAction(Shoot),
+							}),
+							{ { 2, 0.f, 100.f, -1.f, 1.f }, { 3, 0.f, 1.f, 1.f, 0.f } }, 1.2f
+						},
+						{ new BehaviorAction(AimAtEnemy), { { 2, 0.f, 16.f, -1.f, 1.f }, { 3, 0.f, 1.f, 1.f, 0.f } }, 1.f },
+						//Below the old 7.1/8.1 thresholds, scaled by how low the stat is
+						{ new BehaviorAction(UseFood), { { 0, 0.f, 7.1f, -1.f, 1.f }, { 6, 0.f, 1.f, 1.f, 0.f } }, 1.5f },
+						{ new BehaviorAction(UseMedkit), { { 1, 0.f, 8.1f, -1.f, 1.f }, { 7, 0.f, 1.f, 1.f, 0.f } }, 1.5f },
+						//Picking up items at 5 Hz, in between the last result (and the item as target) is kept
+						{ new BehaviorThrottle(new BehaviorAction(OptimizeInventory), 0.2f), { { 5, 0.f, 1.f, 1.f, 0.f } }, 0.25f },
 					}),
 				//eNEMYhANDLING
 				new BehaviorSequence(
@@ -407,7 +287,12 @@ void Plugin::InitBehavior()
 							//Hasgun 1st, less calculations used if has no gun
 						new BehaviorConditional(HasGun),
 						new BehaviorConditional(IsBitten),
-						new BehaviorAction(Turn),
+						//Turn towards the bite for 2 seconds
+						new BehaviorSelector(
+						{
+							new BehaviorTimeLimit(new BehaviorAction(Turn), 2.f),
+							new BehaviorAction(StopTurning),
+						}),
 				}),
 
 				
@@ -416,66 +301,15 @@ void Plugin::InitBehavior()
 						new BehaviorConditional(IsCloseToBorder),
 						new BehaviorAction(GoBack),
 					}),
-new BehaviorSelector(
-	{
-
-		//Item Usage
+		//Wander for 5 seconds after leaving purgezone
 		new BehaviorSequence(
 			{
-				new BehaviorConditional(IsHungry),
-				new BehaviorConditional(HasItemOfAgentState),
-				new BehaviorAction(UseItemOfType),
-			}),
-
-		new BehaviorSequence(
-			{
-				new BehaviorConditional(IsInjured),
-				new BehaviorConditional(HasItemOfAgentState),
-				new BehaviorAction(UseItemOfType),
-			}),
-
-
-
-
-	}),
-
-	//Picking up items
-	new BehaviorSelector(
-		{
-
-			new BehaviorSequence(
-				{
-					new BehaviorConditional(HasFreeSlot),
-					new BehaviorConditional(IsNearItems),
-					new BehaviorConditional(IsHungry),
-					new BehaviorConditional(IsItemOfTypeNearby),
-					new BehaviorAction(GetItemOfType),
-				}),
-
-				new BehaviorSequence(
-				{
-					new BehaviorConditional(HasFreeSlot),
-					new BehaviorConditional(IsNearItems),
-					new BehaviorConditional(IsInjured),
-					new BehaviorConditional(IsItemOfTypeNearby),
-					new BehaviorAction(GetItemOfType),
-				}),
-
-			new BehaviorSequence(
+				new BehaviorConditional(IsWanderActive),
+				new BehaviorSelector(
 				{
-					new BehaviorConditional(HasFreeSlot),
-					new BehaviorConditional(IsNearItems),
-					new BehaviorAction(GetItem),
+					new BehaviorTimeLimit(new BehaviorAction(KeepWandering), 5.f),
+					new BehaviorAction(StopWandering),
 				}),
-
-
-		}),
-
-		//Wander after leaving purgezone
-		new BehaviorSequence(
-			{
-				new BehaviorConditional(IsWanderActive),
-				new BehaviorAction(ChangeToWander),
 			}),
 
 		//House exploring
@@ -490,98 +324,87 @@ new BehaviorSelector(
 				new BehaviorSequence(
 				{
 
-					new BehaviorConditional(IsHouseExplored),
+					new BehaviorConditional(IsHouseExplored, { "Houses", "Agent", "LeavingHouse" }),
 					new BehaviorAction(LeaveHouse),
 				}),
 				new BehaviorSequence(
 				{
-					new BehaviorConditional(IsNearHouse),
+					new BehaviorConditional(IsNearHouse, { "Agent", "Houses", "GoingInside" }),
 					new BehaviorAction(EnterHouse),
 				}),
 				new BehaviorSequence(
 				{
-					new BehaviorConditional(GoingInside),
+					new BehaviorConditional(GoingInside, { "GoingInside" }),
 					new BehaviorAction(ChangeToSeek),
 				}),
 				new BehaviorSequence
 				({
-					new BehaviorConditional(IsInHouse),
-					new BehaviorConditional(IsForAWhile),
-					new BehaviorAction(EscapeHouse),
+					new BehaviorConditional(IsInHouse, { "Agent", "Houses" }),
+					//Nudge out of the house at most every 5 seconds
+					new BehaviorCooldown(new BehaviorAction(EscapeHouse), 5.f),
 				}),
 			}),
 		
 				new BehaviorSequence(
 				{
-					new BehaviorConditional(ExploredWaypoint),
+					new BehaviorConditional(ExploredWaypoint, { "Agent", "Target" }),
 					new BehaviorAction(FollowGrid),
 				}),
 				new BehaviorAction(ChangeToSeek),
 				
-			}));
-
-	
+			});
+
+#ifdef USE_FLAT_BEHAVIOR_TREE
+	auto pFlatBT = new FlatBehaviorTree(m_pB, pRoot);
+	pFlatBT->SetReactive(true); //Conditionals with read keys are cached, their data has to go through ChangeData/MarkChanged
+	m_pBT = pFlatBT;
+#else
+	m_pBT = new BehaviorTree(m_pB, pRoot);
+#endif
 }
 SteeringPlugin_Output Plugin::HandleSteering(const float dt)
 {
 	SteeringPlugin_Output steering{};
-	std::string mapID{};
-	Vector2 target{};
-	//use behavior string to set correct behavior
-	m_pB->GetData("Behavior", mapID);
+	SteeringType activeSteering{ m_ActiveSteering };
+	//use behavior type to set correct behavior
+	m_pB->GetData("Behavior", activeSteering);
 	m_pB->GetData("Target", m_Target);
 
 	//Reset wanderangle to curr Agent angle
-	if (mapID != std::string{ "Wander" })
+	if (activeSteering != SteeringType::Wander)
+	{
+		m_Steering.GetBehavior(SteeringType::Wander)->As<Wander>()->UpdateWanderAngle(ToDegrees(m_Frame.GetAgent().Orientation - static_cast<float>(M_PI)/2));
+	}
+
+	//Only the behavior picked by the tree is swapped, the layers stay enabled
+	if (activeSteering != m_ActiveSteering)
 	{
-		static_cast<Wander*>(m_pBehaviors["Wander"])->UpdateWanderAngle(ToDegrees(m_pInterface->Agent_GetInfo().Orientation - static_cast<float>(M_PI)/2));
+		m_Steering.SetEnabled(m_ActiveSteering, false);
+		m_Steering.SetEnabled(activeSteering, true);
+		m_ActiveSteering = activeSteering;
 	}
 
-	m_pBehaviors[mapID]->SetTarget(m_Target);
+	m_Steering.GetBehavior(activeSteering)->SetTarget(m_Target);
 	steering.AutoOrient = true; //Setting AutoOrientate to TRue overrides the AngularVelocity
-	steering = m_pBehaviors[mapID]->CalculateSteering(dt, m_pInterface);
+	steering = m_Steering.CalculateSteering(dt, m_Frame);
 	steering.RunMode = m_CanRun; //If RunMode is True > MaxLinSpd is increased for a limited time (till your stamina runs out)
-	if (m_pInterface->Agent_GetInfo().WasBitten && m_pInterface->Agent_GetInfo().Stamina >= 5)
+	const AgentInfo& agent{ m_Frame.GetAgent() };
+	if (agent.WasBitten && agent.Stamina >= 5)
 		m_Run = true;
-	if (m_pInterface->Agent_GetInfo().Stamina <= 0)
+	if (agent.Stamina <= 0)
 		m_Run = false;
 		steering.RunMode = m_Run;
 
+#ifdef USE_ORCA_AVOIDANCE
+	//The chosen velocity is the preferred one, ORCA only changes it as much as needed to not walk into a moving enemy
+	steering.LinearVelocity = m_Orca.ComputeSafeVelocity(agent, m_Frame.GetPerception(), steering.LinearVelocity, dt);
+#endif
 
-	//std::cout << "Behavior: " << mapID << std::endl;
+	//std::cout << "Behavior: " << static_cast<int>(activeSteering) << std::endl;
 
 	return steering;
 }
 
-void Plugin::HandleTimers(const float dt)
-{
-	bool turning{};
-	m_pB->GetData("Turning", turning);
-	if (turning || m_pInterface->Agent_GetInfo().IsInHouse)
-	{
-		m_Cooldown += dt;
-		if (m_Cooldown >= 5)
-			m_Cooldown = 0;
-		if (turning && m_Cooldown >= 2.f)
-		{
-			m_Cooldown = 0;
-			m_pB->ChangeData("Turning", false);
-		}
-	}
-
-
-	//Wander functionality
-	float wanderTimer{};
-	m_pB->GetData("WanderTimer", wanderTimer);
-
-	if (wanderTimer > FLT_EPSILON)
-	{
-		wanderTimer -= dt;
-		m_pB->ChangeData("WanderTimer", wanderTimer);
-	}
-
-}
-
 void Plugin::HandleHouses()
 {
 	std::vector<HouseInfo*> vHousesInFOV{};
@@ -598,10 +421,14 @@ void Plugin::HandleHouses()
 	{
 		//std::cout << "THERE IS HOUSE EXPLORED" << std::endl;
 	}
-	for (size_t i{}; i < GetHousesInFOV().size(); i++)
+	const std::vector<HouseInfo>& housesInFOV{ m_Frame.GetHousesInFOV() };
+#ifdef USE_LOCAL_NAVMESH
+	m_Frame.UpdateNavMesh();
+#endif
+	for (size_t i{}; i < housesInFOV.size(); i++)
 	{
 		//Check for yet explored houses
-		HouseInfo* pHouse{ new HouseInfo(GetHousesInFOV()[i]) };
+		HouseInfo* pHouse{ new HouseInfo(housesInFOV[i]) };
 		auto it{ std::find_if(pExploredHouses.cbegin(), pExploredHouses.cend(), [&pHouse](const HouseInfo* pExploredHouse) {return int(pExploredHouse->Center.x) == int(pHouse->Center.x) && int(pExploredHouse->Center.y) == int(pHouse->Center.y); }) };
 		if (it == pExploredHouses.cend())
 		{
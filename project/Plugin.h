@@ -1,8 +1,13 @@
 #pragma once
 #include "IExamPlugin.h"
 #include "Exam_HelperStructs.h"
-#include "SteeringBehaviors.h"
+#include "SteeringPipeline.h"
+#include "OrcaAvoidance.h"
 #include "EGridGraph.h"
+#include "FrameSnapshot.h"
+#include "ExplorationPlanner.h"
+#include "Inventory.h"
+#include "InventoryOptimizer.h"
 
 class IBaseInterface;
 class IExamInterface;
@@ -26,8 +31,8 @@ public:
 private:
 	//Interface, used to request data from/perform actions with the AI Framework
 	IExamInterface* m_pInterface = nullptr;
-	vector<HouseInfo> GetHousesInFOV() const;
-	vector<EntityInfo> GetEntitiesInFOV() const;
+	//Everything queried from the interface this tick
+	FrameSnapshot m_Frame{};
 
 	//------ADDED FUNCTIONS-------
 	//Helpers
@@ -35,14 +40,10 @@ private:
 	//inits
 	void InitBehavior();
 	void InitBlackboard();
-	void InitGrid(int cellSize);
 	//Handlers
-	void HandleTimers(const float dt);
 	void HandleHouses();
+	void HandleExploration(const float dt);
 	void HandleEntities();
-	void HandleEnemy(const EntityInfo& eInfo, std::vector<EnemyInfo*>& pEnemiesInSight);
-	void HandleItem(EntityInfo& eInfo, std::vector<std::pair<EntityInfo, ItemInfo*>>& pItemsInSight);
-	void HandlePurgeZone(const EntityInfo& eInfo, std::vector<PurgeZoneInfo*>& pPurgeZones);
 	void HandleItemManagement();
 	SteeringPlugin_Output HandleSteering(const float dt);
 	//----------------------------
@@ -56,19 +57,19 @@ private:
 	float m_AngSpeed = 0.f; //Demo purpose
 	//------ADDED VARIABLES-------
 	bool m_Run;
-	int m_Rows;
-	int m_Cols;
-	float m_Cooldown;
 	//Behavior
-	BehaviorTree* m_pBT;
+	IDecisionMaking* m_pBT; //BehaviorTree or FlatBehaviorTree, both own the blackboard
 	std::vector<HouseInfo*> m_pExploredHouses{};
 	//Containers
 	Blackboard* m_pB;
-	std::unordered_map<int,std::pair<bool,Vector2>> m_pWayPoints;
-	std::unordered_map<unsigned char, ItemInfo*> m_pInventory;
+	ExplorationPlanner m_Exploration{};
+	Inventory m_Inventory{};
+	InventoryOptimizer m_InventoryOptimizer{};
 	//Saving enemypointers to look at distance of enemies outside of FOV (if enemy gets too close, shoot if possible, if too far, delete from vector)
 	std::vector<EnemyInfo*> m_pEnemies;
-	std::unordered_map<std::string, ISteeringBehavior*> m_pBehaviors;
+	SteeringPipeline m_Steering{};
+	SteeringType m_ActiveSteering = SteeringType::Wander; //Behavior picked by the tree last tick
+	OrcaAvoidance m_Orca{};
 	//----------------------------
 };
 
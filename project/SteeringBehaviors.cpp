@@ -4,39 +4,43 @@
 //Includes
 #include "SteeringBehaviors.h"
 #include "IExamInterface.h"
+#ifdef USE_SSE_EVASION
+#include <xmmintrin.h>
+#endif
 //SEEK
 //****
-SteeringPlugin_Output Seek::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Seek::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{pInterface->Agent_GetInfo()};
-	steering.LinearVelocity = pInterface->NavMesh_GetClosestPathPoint(m_Target.Position) - agent.Position; //Desired v
+	const AgentInfo& agent{ frame.GetAgent() };
+	steering.LinearVelocity = frame.GetClosestPathPoint(m_Target.Position) - agent.Position; //Desired v
 	steering.LinearVelocity.Normalize(); //normalize to control speed
 	steering.LinearVelocity *= agent.MaxLinearSpeed; //rescale to max speed
 
 
 	return steering; //return steering
 }
-bool Seek::HasReachedDestination(const IExamInterface* pInterface) const
+bool Seek::HasReachedDestination(const FrameSnapshot& frame) const
 {
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
+	const AgentInfo& agent{ frame.GetAgent() };
 	float fromTargetSqr{ Elite::Vector2(m_Target.Position - agent.Position).SqrtMagnitude() };
 	return fromTargetSqr <= (agent.AgentSize * agent.AgentSize);
 }
 
 //WANDER (base> SEEK)
 //******
-SteeringPlugin_Output Wander::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Wander::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
-	Vector2 dir{cosf(agent.Orientation - static_cast<float>(M_PI) /2), sinf(agent.Orientation- static_cast<float>(M_PI) /2)};
-	dir = dir.GetNormalized();
+	const AgentInfo& agent{ frame.GetAgent() };
+	const Vector2& dir{ frame.GetAgentBasis().Forward };
 
 	Elite::Vector2 circle{ agent.Position + dir * m_WanderOffset }; //circle center location
 	m_WanderAngle = randomFloat(m_WanderAngle - m_WanderMaxAngle / 2, m_WanderAngle + m_WanderMaxAngle / 2);
 	//std::cout << m_WanderAngle << std::endl;//new wander angle is inbetween boundaries of prev angle and max change
-	Elite::Vector2 pointOnCircle{circle.x + m_WanderRadius * cosf(ToRadians(m_WanderAngle)), circle.y + m_WanderRadius * sinf(ToRadians(m_WanderAngle))}; //Calculate point on circle
+	float sine{}, cosine{};
+	SinCosFst(ToRadians(m_WanderAngle), sine, cosine);
+	Elite::Vector2 pointOnCircle{circle.x + m_WanderRadius * cosine, circle.y + m_WanderRadius * sine}; //Calculate point on circle
 
 	steering.LinearVelocity = pointOnCircle - agent.Position;
 	steering.LinearVelocity.Normalize();
@@ -46,12 +50,11 @@ SteeringPlugin_Output Wander::CalculateSteering(float deltaT, IExamInterface* pI
 	return steering;
 }
 
-SteeringPlugin_Output Flee::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Flee::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
 
-	steering = Seek::CalculateSteering(deltaT, pInterface);
+	steering = Seek::CalculateSteering(deltaT, frame);
 	steering.AngularVelocity *= -1;
 	steering.LinearVelocity *= -1;
 
@@ -59,29 +62,29 @@ SteeringPlugin_Output Flee::CalculateSteering(float deltaT, IExamInterface* pInt
 }
 
 
-SteeringPlugin_Output Arrive::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Arrive::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	float radius{ 20 };
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
+	const AgentInfo& agent{ frame.GetAgent() };
 
-	steering = Seek::CalculateSteering(deltaT, pInterface);
+	steering = Seek::CalculateSteering(deltaT, frame);
 	float distanceAgentToTarget{ (m_Target.Position - agent.Position).Magnitude() };
 	if (radius > distanceAgentToTarget)
 	{
 		steering.LinearVelocity = steering.LinearVelocity.GetNormalized() * agent.MaxLinearSpeed * (distanceAgentToTarget / radius);
 	}
 	else
-		steering = Seek::CalculateSteering(deltaT, pInterface);
+		steering = Seek::CalculateSteering(deltaT, frame);
 
 	return steering;
 }
 
 
-SteeringPlugin_Output Pursuit::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Pursuit::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
+	const AgentInfo& agent{ frame.GetAgent() };
 
 	Elite::Vector2 toTarget{ m_Target.Position - agent.Position };
 	float distanceToTarget{ toTarget.Magnitude() };
@@ -95,36 +98,135 @@ SteeringPlugin_Output Pursuit::CalculateSteering(float deltaT, IExamInterface* p
 	return steering;
 }
 
-SteeringPlugin_Output Evade::CalculateSteering(float deltaT,  IExamInterface* pInterface) //AddRadius
+SteeringPlugin_Output Evade::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
+	const AgentInfo& agent{ frame.GetAgent() };
+	const PerceptionBuffers& perception{ frame.GetPerception() };
 	steering.AutoOrient = true;
-	//player dir (to make player face enemy)
-	Elite::Vector2 toTarget{ m_Target.Position - agent.Position };
-	float distanceToTarget{ toTarget.Magnitude() };
-	if (distanceToTarget > m_EvadeRadius)
+
+	Vector2 avoidance{ CalculateThreatAvoidance(perception.EnemyPositionsX.data(), perception.EnemyPositionsY.data(),
+		perception.EnemyVelocitiesX.data(), perception.EnemyVelocitiesY.data(), perception.Enemies.size(),
+		agent.Position, agent.LinearVelocity, m_EvadeRadius, m_ThreatRadius, m_TimeHorizon) };
+
+	if (avoidance == ZeroVector2)
 	{
-		return steering;
+		//No enemy is heading our way, still keep away from the target if it's close
+		avoidance = agent.Position - m_Target.Position;
+		if (avoidance == ZeroVector2 || avoidance.SqrtMagnitude() > m_EvadeRadius * m_EvadeRadius)
+			return steering;
 	}
-	toTarget.Normalize();
-	//take future prediction of target pos as true target
-	Elite::Vector2 toTargetFuture{ (m_Target.Position + Vector2{4,4} *(distanceToTarget / agent.MaxLinearSpeed)) - agent.Position }; //distance/agentmaxspeed for a more realistic, responsive predict
-	steering.LinearVelocity = toTargetFuture;
+
+	steering.LinearVelocity = avoidance;
 	steering.LinearVelocity.Normalize();
 	steering.LinearVelocity *= agent.MaxLinearSpeed; //We want to choose own speed
+	return steering;
+}
 
-	//Make player face enemy
-	Vector2 dir{ cosf(agent.Orientation), sinf(agent.Orientation) };
-	float angle{Dot(toTarget, dir)/(toTarget.Magnitude()*dir.Magnitude())};
-	steering.AngularVelocity = angle;
-	std::cout << steering.AngularVelocity << std::endl;
-	steering.LinearVelocity *= -1; //Same as pursuit (predicting a future target to go to but flee from that future target (pursuit mixed with flee)
+Elite::Vector2 CalculateThreatAvoidance(const float* pPositionsX, const float* pPositionsY, const float* pVelocitiesX, const float* pVelocitiesY, size_t count,
+	const Elite::Vector2& position, const Elite::Vector2& velocity, float maxRange, float threatRadius, float timeHorizon)
+{
+	//Per threat, relative to the agent: p = position, v = velocity
+	//t = clamp(-dot(p, v) / dot(v, v), 0, horizon), closest approach c = p + v * t
+	//Pushed away along -c, head-on (c ~ 0) along -p, and along the perpendicular of v when p ~ 0 too
+	const float maxRangeSquared{ maxRange * maxRange };
+	const float threatRadiusSquared{ threatRadius * threatRadius };
+	const float epsilon{ 1e-4f };
+	const float headOnSquared{ 1e-2f };
+	float sumX{};
+	float sumY{};
+	size_t i{};
 
-	return steering;
+#ifdef USE_SSE_EVASION
+	const __m128 agentX{ _mm_set1_ps(position.x) };
+	const __m128 agentY{ _mm_set1_ps(position.y) };
+	const __m128 agentVX{ _mm_set1_ps(velocity.x) };
+	const __m128 agentVY{ _mm_set1_ps(velocity.y) };
+	const __m128 rangeSq{ _mm_set1_ps(maxRangeSquared) };
+	const __m128 radiusSq{ _mm_set1_ps(threatRadiusSquared) };
+	const __m128 invRadiusSq{ _mm_set1_ps(1.f / threatRadiusSquared) };
+	const __m128 horizon{ _mm_set1_ps(timeHorizon) };
+	const __m128 eps{ _mm_set1_ps(epsilon) };
+	const __m128 headOnSq{ _mm_set1_ps(headOnSquared) };
+	const __m128 zero{ _mm_setzero_ps() };
+	const __m128 one{ _mm_set1_ps(1.f) };
+	__m128 accX{ zero };
+	__m128 accY{ zero };
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 px{ _mm_sub_ps(_mm_loadu_ps(pPositionsX + i), agentX) };
+		const __m128 py{ _mm_sub_ps(_mm_loadu_ps(pPositionsY + i), agentY) };
+		const __m128 vx{ _mm_sub_ps(_mm_loadu_ps(pVelocitiesX + i), agentVX) };
+		const __m128 vy{ _mm_sub_ps(_mm_loadu_ps(pVelocitiesY + i), agentVY) };
+
+		const __m128 pp{ _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)) };
+		const __m128 pv{ _mm_add_ps(_mm_mul_ps(px, vx), _mm_mul_ps(py, vy)) };
+		const __m128 vv{ _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)) };
+		__m128 t{ _mm_div_ps(_mm_sub_ps(zero, pv), _mm_max_ps(vv, eps)) };
+		t = _mm_min_ps(_mm_max_ps(t, zero), horizon);
+
+		const __m128 cx{ _mm_add_ps(px, _mm_mul_ps(vx, t)) };
+		const __m128 cy{ _mm_add_ps(py, _mm_mul_ps(vy, t)) };
+		const __m128 cc{ _mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)) };
+
+		//Direction to push away from, selected per lane with and/andnot
+		const __m128 isHeadOn{ _mm_cmplt_ps(cc, headOnSq) };
+		const __m128 isOnTop{ _mm_cmplt_ps(pp, headOnSq) };
+		const __m128 fallbackX{ _mm_or_ps(_mm_and_ps(isOnTop, _mm_sub_ps(zero, vy)), _mm_andnot_ps(isOnTop, px)) };
+		const __m128 fallbackY{ _mm_or_ps(_mm_and_ps(isOnTop, vx), _mm_andnot_ps(isOnTop, py)) };
+		const __m128 dx{ _mm_or_ps(_mm_and_ps(isHeadOn, fallbackX), _mm_andnot_ps(isHeadOn, cx)) };
+		const __m128 dy{ _mm_or_ps(_mm_and_ps(isHeadOn, fallbackY), _mm_andnot_ps(isHeadOn, cy)) };
+		const __m128 dd{ _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)) };
+
+		const __m128 isThreat{ _mm_and_ps(_mm_cmplt_ps(pp, rangeSq), _mm_cmplt_ps(cc, radiusSq)) };
+		const __m128 urgency{ _mm_div_ps(_mm_sub_ps(one, _mm_mul_ps(cc, invRadiusSq)), _mm_add_ps(one, t)) };
+		const __m128 weight{ _mm_and_ps(isThreat, _mm_div_ps(urgency, _mm_sqrt_ps(_mm_add_ps(dd, eps)))) };
+
+		accX = _mm_sub_ps(accX, _mm_mul_ps(dx, weight));
+		accY = _mm_sub_ps(accY, _mm_mul_ps(dy, weight));
+	}
+
+	float lanesX[4];
+	float lanesY[4];
+	_mm_storeu_ps(lanesX, accX);
+	_mm_storeu_ps(lanesY, accY);
+	sumX = (lanesX[0] + lanesX[1]) + (lanesX[2] + lanesX[3]);
+	sumY = (lanesY[0] + lanesY[1]) + (lanesY[2] + lanesY[3]);
+#endif
+
+	//Remainder (or everything without SSE), same math
+	for (; i < count; ++i)
+	{
+		const float px{ pPositionsX[i] - position.x };
+		const float py{ pPositionsY[i] - position.y };
+		const float vx{ pVelocitiesX[i] - velocity.x };
+		const float vy{ pVelocitiesY[i] - velocity.y };
+
+		const float pp{ px * px + py * py };
+		const float vv{ vx * vx + vy * vy };
+		const float t{ Clamp(-(px * vx + py * vy) / (std::max)(vv, epsilon), 0.f, timeHorizon) };
+		const float cx{ px + vx * t };
+		const float cy{ py + vy * t };
+		const float cc{ cx * cx + cy * cy };
+		if (pp >= maxRangeSquared || cc >= threatRadiusSquared)
+			continue;
+
+		float dx{ cx };
+		float dy{ cy };
+		if (cc < headOnSquared)
+		{
+			dx = pp < headOnSquared ? -vy : px;
+			dy = pp < headOnSquared ? vx : py;
+		}
+		const float weight{ (1.f - cc / threatRadiusSquared) / (1.f + t) / sqrtf(dx * dx + dy * dy + epsilon) };
+		sumX -= dx * weight;
+		sumY -= dy * weight;
+	}
+	return Elite::Vector2{ sumX, sumY };
 }
 
-SteeringPlugin_Output Dodge::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Dodge::CalculateSteering(float deltaT, const FrameSnapshot&)
 {
 	SteeringPlugin_Output steering{};
 	
@@ -132,26 +234,27 @@ SteeringPlugin_Output Dodge::CalculateSteering(float deltaT, IExamInterface* pIn
 	return steering;
 }
 
-SteeringPlugin_Output Face::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output Face::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 
 	SteeringPlugin_Output steering{ };
-	Vector2 toTarget{ m_Target - pInterface->Agent_GetInfo().Position };
-	Vector2 dir{ cosf(pInterface->Agent_GetInfo().Orientation), sinf(pInterface->Agent_GetInfo().Orientation) };
-	float angle{ Dot(toTarget, dir) / (toTarget.Magnitude() * dir.Magnitude()) };
+	const AgentInfo& agent{ frame.GetAgent() };
+	Vector2 toTarget{ m_Target - agent.Position };
+	const Vector2& dir{ frame.GetAgentBasis().Side };
+	float angle{ Dot(toTarget, dir) / toTarget.Magnitude() };
 	steering.AutoOrient = false;
 	steering.AngularVelocity = angle*10;
 	
-	pInterface->Draw_Segment(pInterface->Agent_GetInfo().Position, pInterface->Agent_GetInfo().Position + m_Target - pInterface->Agent_GetInfo().Position, Vector3{ 1,0,0 });
+	frame.GetInterface()->Draw_Segment(agent.Position, agent.Position + m_Target - agent.Position, Vector3{ 1,0,0 });
 	std::cout << "FACE" << std::endl;
 	return steering;
 }
 
-SteeringPlugin_Output FaceSeek::CalculateSteering(float deltaT, IExamInterface* pInterface)
+SteeringPlugin_Output FaceSeek::CalculateSteering(float deltaT, const FrameSnapshot& frame)
 {
 	SteeringPlugin_Output steering{};
-	AgentInfo agent{ pInterface->Agent_GetInfo() };
-	steering.LinearVelocity = pInterface->NavMesh_GetClosestPathPoint(m_Target.Position) - agent.Position; //Desired v
+	const AgentInfo& agent{ frame.GetAgent() };
+	steering.LinearVelocity = frame.GetClosestPathPoint(m_Target.Position) - agent.Position; //Desired v
 	steering.LinearVelocity.Normalize(); //normalize to control speed
 	steering.LinearVelocity *= agent.MaxLinearSpeed; //rescale to max speed
 
@@ -161,3 +264,162 @@ SteeringPlugin_Output FaceSeek::CalculateSteering(float deltaT, IExamInterface*
 
 	return steering;
 }
+
+SteeringPlugin_Output AvoidPurgeZone::CalculateSteering(float deltaT, const FrameSnapshot& frame)
+{
+	SteeringPlugin_Output steering{};
+	const AgentInfo& agent{ frame.GetAgent() };
+	const std::vector<PurgeZoneInfo>& purgeZones{ frame.GetPerception().PurgeZones };
+
+	const PurgeZoneInfo* pClosest{ nullptr };
+	float closestDistanceSquared{ FLT_MAX };
+	for (const PurgeZoneInfo& zone : purgeZones)
+	{
+		const float distanceSquared{ DistanceSquared(zone.Center, agent.Position) };
+		if (distanceSquared < closestDistanceSquared)
+		{
+			closestDistanceSquared = distanceSquared;
+			pClosest = &zone;
+		}
+	}
+	const float range{ pClosest ? pClosest->Radius + m_Margin : 0.f };
+	if (!pClosest || closestDistanceSquared >= range * range)
+		return steering;
+
+	steering.LinearVelocity = agent.Position - pClosest->Center;
+	if (steering.LinearVelocity == ZeroVector2)
+		steering.LinearVelocity = Vector2{ 1.f, 0.f }; //Dead center, any direction gets out
+	steering.LinearVelocity.Normalize();
+	steering.LinearVelocity *= agent.MaxLinearSpeed;
+	return steering;
+}
+
+SteeringPlugin_Output AvoidBorder::CalculateSteering(float deltaT, const FrameSnapshot& frame)
+{
+	SteeringPlugin_Output steering{};
+	const AgentInfo& agent{ frame.GetAgent() };
+	const WorldInfo& world{ frame.GetWorld() };
+
+	const Vector2 halfDimensions{ world.Dimensions / 2.f };
+	const Vector2 fromCenter{ agent.Position - world.Center };
+	if (abs(fromCenter.x) < halfDimensions.x - m_Margin && abs(fromCenter.y) < halfDimensions.y - m_Margin)
+		return steering;
+
+	steering.LinearVelocity = world.Center - agent.Position;
+	steering.LinearVelocity.Normalize();
+	steering.LinearVelocity *= agent.MaxLinearSpeed;
+	return steering;
+}
+
+ContextSteering::ContextSteering()
+{
+	std::array<float, SlotCount> angles{};
+	for (size_t i{}; i < SlotCount; ++i)
+		angles[i] = static_cast<float>(i) * 2.f * static_cast<float>(M_PI) / SlotCount;
+	SinCosFst(angles.data(), m_DirectionsY.data(), m_DirectionsX.data(), SlotCount);
+}
+
+SteeringPlugin_Output ContextSteering::CalculateSteering(float deltaT, const FrameSnapshot& frame)
+{
+	SteeringPlugin_Output steering{};
+	const AgentInfo& agent{ frame.GetAgent() };
+	m_Interest.fill(0.f);
+	m_Danger.fill(0.f);
+
+	//Interest: the next point on the path to the target
+	Vector2 toTarget{ frame.GetClosestPathPoint(m_Target.Position) - agent.Position };
+	if (toTarget != ZeroVector2)
+		AddToMap(m_Interest, toTarget.GetNormalized(), 1.f);
+
+	//Danger: enemies, closer is worse
+	const PerceptionBuffers& perception{ frame.GetPerception() };
+	for (size_t i{}; i < perception.Enemies.size(); ++i)
+	{
+		const Vector2 toEnemy{ perception.EnemyPositionsX[i] - agent.Position.x, perception.EnemyPositionsY[i] - agent.Position.y };
+		const float distance{ toEnemy.Magnitude() };
+		if (distance < m_DangerRange && distance > 0.f)
+			AddToMap(m_Danger, toEnemy / distance, 1.f - distance / m_DangerRange);
+	}
+
+	//Danger: purge zones, full danger inside, fading out over the margin
+	for (const PurgeZoneInfo& zone : perception.PurgeZones)
+	{
+		const Vector2 toZone{ zone.Center - agent.Position };
+		const float distance{ toZone.Magnitude() };
+		const float distanceToEdge{ distance - zone.Radius };
+		if (distanceToEdge < m_PurgeZoneMargin && distance > 0.f)
+			AddToMap(m_Danger, toZone / distance, Clamp(1.f - distanceToEdge / m_PurgeZoneMargin, 0.f, 1.f));
+	}
+
+	//Danger: world border, one input per side that is within the margin
+	const WorldInfo& world{ frame.GetWorld() };
+	const Vector2 halfDimensions{ world.Dimensions / 2.f };
+	const Vector2 fromCenter{ agent.Position - world.Center };
+	const float toRight{ halfDimensions.x - fromCenter.x };
+	const float toLeft{ halfDimensions.x + fromCenter.x };
+	const float toTop{ halfDimensions.y - fromCenter.y };
+	const float toBottom{ halfDimensions.y + fromCenter.y };
+	if (toRight < m_BorderMargin)
+		AddToMap(m_Danger, Vector2{ 1.f, 0.f }, 1.f - toRight / m_BorderMargin);
+	if (toLeft < m_BorderMargin)
+		AddToMap(m_Danger, Vector2{ -1.f, 0.f }, 1.f - toLeft / m_BorderMargin);
+	if (toTop < m_BorderMargin)
+		AddToMap(m_Danger, Vector2{ 0.f, 1.f }, 1.f - toTop / m_BorderMargin);
+	if (toBottom < m_BorderMargin)
+		AddToMap(m_Danger, Vector2{ 0.f, -1.f }, 1.f - toBottom / m_BorderMargin);
+
+	const int slot{ ResolveSlot() };
+	if (slot < 0)
+		return steering;
+
+	steering.LinearVelocity = Vector2{ m_DirectionsX[slot], m_DirectionsY[slot] } * agent.MaxLinearSpeed;
+	return steering;
+}
+
+void ContextSteering::AddToMap(std::array<float, SlotCount>& map, const Elite::Vector2& direction, float weight)
+{
+	//Fixed trip count and no branches, vectorizes
+	const float* pX{ m_DirectionsX.data() };
+	const float* pY{ m_DirectionsY.data() };
+	float* pMap{ map.data() };
+	for (size_t i{}; i < SlotCount; ++i)
+	{
+		const float value{ weight * (pX[i] * direction.x + pY[i] * direction.y) };
+		pMap[i] = (std::max)(pMap[i], value);
+	}
+}
+
+int ContextSteering::ResolveSlot() const
+{
+	float minDanger{ FLT_MAX };
+	float maxDanger{};
+	for (size_t i{}; i < SlotCount; ++i)
+	{
+		minDanger = (std::min)(minDanger, m_Danger[i]);
+		maxDanger = (std::max)(maxDanger, m_Danger[i]);
+	}
+
+	//Masked interest, slots above the tolerance get -1 so they never win
+	const float maxAllowedDanger{ minDanger + m_DangerTolerance };
+	int bestSlot{ -1 };
+	float bestInterest{ 0.f };
+	for (size_t i{}; i < SlotCount; ++i)
+	{
+		const float maskedInterest{ m_Danger[i] <= maxAllowedDanger ? m_Interest[i] : -1.f };
+		if (maskedInterest > bestInterest)
+		{
+			bestInterest = maskedInterest;
+			bestSlot = static_cast<int>(i);
+		}
+	}
+	if (bestSlot >= 0 || maxDanger <= 0.f)
+		return bestSlot;
+
+	//Nothing interesting in a safe direction, just take the safest one
+	for (size_t i{}; i < SlotCount; ++i)
+	{
+		if (m_Danger[i] == minDanger)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
@@ -13,9 +13,14 @@
 #include "Exam_HelperStructs.h"
 
 #include "SteeringHelpers.h"
+#include "FrameSnapshot.h"
+#include <array>
 class IExamInterface;
 using namespace Elite;
 
+//=== Options ===
+#define USE_SSE_EVASION //4 enemies per iteration in CalculateThreatAvoidance
+
 #pragma region **ISTEERINGBEHAVIOR** (BASE)
 class ISteeringBehavior
 {
@@ -23,7 +28,7 @@ public:
 	ISteeringBehavior() = default;
 	virtual ~ISteeringBehavior() = default;
 
-	virtual SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) = 0;
+	virtual SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) = 0;
 
 	//Seek Functions
 	virtual void SetTarget(const TargetData& target) { m_Target = target; }
@@ -47,8 +52,8 @@ public:
 	virtual ~Seek() = default;
 
 	//Seek Behaviour
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
-	bool HasReachedDestination(const IExamInterface* pInterface) const;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
+	bool HasReachedDestination(const FrameSnapshot& frame) const;
 };
 
 //////////////////////////
@@ -60,7 +65,7 @@ public:
 	Flee() = default;
 	virtual ~Flee() = default;
 
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 };
 
 //////////////////////////
@@ -72,7 +77,7 @@ public:
 	Arrive() :m_SlowRadius{ 15.f }, m_TargetRadius{10.f} {};
 	virtual ~Arrive() = default;
 
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 	void SetSlowRadius(const float& radius) { m_SlowRadius = radius; }
 	void SetTargetRadius(const float& radius) { m_TargetRadius = radius; }
 
@@ -94,7 +99,7 @@ class Face final : public Seek
 		virtual ~Face() = default;
 
 		//Wander Behavior
-		SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface * pInterface) override;
+		SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 
 
 	protected:
@@ -115,7 +120,7 @@ public:
 	virtual ~Wander() = default;
 
 	//Wander Behavior
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 
 	void SetWanderOffset(const float& offset) { m_WanderOffset = offset; };
 	void SetWanderRadius(const float& radius) { m_WanderRadius = radius; };
@@ -143,25 +148,37 @@ public:
 	Pursuit() = default;
 	virtual ~Pursuit() = default;
 
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 };
 
 //////////////////////////
 //EVADE
 //******
+//Evades all enemies in FOV at once: every enemy is moved to the point of closest approach (using its velocity)
+//and pushes the agent away from there, weighted by how close and how soon that is.
+//Falls back to fleeing the target when no enemy is a threat.
 class Evade :public Seek
 {
 public:
 	Evade() = default;
 	virtual ~Evade() = default;
 
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 	void SetEvadeRadius(const float& evadeRadius) { m_EvadeRadius = evadeRadius; }
-	//add radius
+	void SetThreatRadius(float threatRadius) { m_ThreatRadius = threatRadius; }
+	void SetTimeHorizon(float timeHorizon) { m_TimeHorizon = timeHorizon; }
+
 private:
-	float m_EvadeRadius = 200.f;
+	float m_EvadeRadius = 200.f; //Enemies further away are ignored
+	float m_ThreatRadius = 15.f; //Closest approach within this distance is a threat
+	float m_TimeHorizon = 3.f; //Seconds looked ahead
 };
 
+//Sum of the away-from-closest-approach directions of count threats (SoA), each weighted by
+//(1 - closestDistance^2 / threatRadius^2) / (1 + timeToClosestApproach). Zero when nothing is a threat.
+Elite::Vector2 CalculateThreatAvoidance(const float* pPositionsX, const float* pPositionsY, const float* pVelocitiesX, const float* pVelocitiesY, size_t count,
+	const Elite::Vector2& position, const Elite::Vector2& velocity, float maxRange, float threatRadius, float timeHorizon);
+
 //////////////////////////
 //DODGE
 //******
@@ -171,7 +188,7 @@ public:
 	Dodge() = default;
 	virtual ~Dodge() = default;
 
-	SteeringPlugin_Output CalculateSteering(float deltaT,  IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
 	//add radius
 private:
 	float m_Range = 20.f;
@@ -185,8 +202,82 @@ class FaceSeek final : public Seek
 public:
 	FaceSeek() = default;
 	virtual ~FaceSeek() = default;
-	SteeringPlugin_Output CalculateSteering(float deltaT, IExamInterface* pInterface) override;
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
+
+};
+
+//////////////////////////
+//AVOID PURGE ZONE
+//******
+//Flees from the center of the closest purge zone in FOV while within its radius + margin, zero steering otherwise
+class AvoidPurgeZone final : public ISteeringBehavior
+{
+public:
+	AvoidPurgeZone() = default;
+	virtual ~AvoidPurgeZone() = default;
+
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
+	void SetMargin(float margin) { m_Margin = margin; }
+
+private:
+	float m_Margin = 10.f;
+};
+
+//////////////////////////
+//AVOID BORDER
+//******
+//Steers back to the world center when closer than margin to the world border, zero steering otherwise
+class AvoidBorder final : public ISteeringBehavior
+{
+public:
+	AvoidBorder() = default;
+	virtual ~AvoidBorder() = default;
 
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
+	void SetMargin(float margin) { m_Margin = margin; }
+
+private:
+	float m_Margin = 15.f;
+};
+
+//////////////////////////
+//CONTEXT STEERING
+//******
+//Interest and danger per direction slot instead of one steering vector per behavior.
+//Interest comes from the target, danger from enemies, purge zones and the world border.
+//Slots that are clearly more dangerous than the safest one are masked, the most interesting remaining slot wins.
+class ContextSteering final : public Seek
+{
+public:
+	static constexpr size_t SlotCount = 16;
+
+	ContextSteering();
+	virtual ~ContextSteering() = default;
+
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame) override;
+
+	void SetDangerRange(float range) { m_DangerRange = range; }
+	void SetDangerTolerance(float tolerance) { m_DangerTolerance = tolerance; }
+	void SetBorderMargin(float margin) { m_BorderMargin = margin; }
+	void SetPurgeZoneMargin(float margin) { m_PurgeZoneMargin = margin; }
+
+	const std::array<float, SlotCount>& GetInterest() const { return m_Interest; }
+	const std::array<float, SlotCount>& GetDanger() const { return m_Danger; }
+
+private:
+	std::array<float, SlotCount> m_DirectionsX{}; //Unit direction of every slot, slot 0 points along +x
+	std::array<float, SlotCount> m_DirectionsY{};
+	std::array<float, SlotCount> m_Interest{};
+	std::array<float, SlotCount> m_Danger{};
+
+	float m_DangerRange = 20.f; //Enemies further away add no danger
+	float m_DangerTolerance = 0.1f; //Slots up to this much more dangerous than the safest slot stay allowed
+	float m_BorderMargin = 15.f;
+	float m_PurgeZoneMargin = 10.f;
+
+	//Writes max(map[i], weight * dot(slot i, direction)) for every slot, direction has to be normalized
+	void AddToMap(std::array<float, SlotCount>& map, const Elite::Vector2& direction, float weight);
+	int ResolveSlot() const;
 };
 
 #endif
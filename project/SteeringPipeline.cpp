@@ -0,0 +1,88 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "SteeringPipeline.h"
+
+SteeringPipeline::~SteeringPipeline()
+{
+	for (auto& pBehavior : m_pBehaviors)
+		SAFE_DELETE(pBehavior);
+}
+
+void SteeringPipeline::SetBehavior(SteeringType type, ISteeringBehavior* pBehavior, float weight)
+{
+	const size_t idx{ static_cast<size_t>(type) };
+	SAFE_DELETE(m_pBehaviors[idx]);
+	m_pBehaviors[idx] = pBehavior;
+	m_Weights[idx] = weight;
+	m_EnabledMask &= ~ToMask(type);
+}
+
+void SteeringPipeline::SetEnabled(SteeringType type, bool isEnabled)
+{
+	if (isEnabled && m_pBehaviors[static_cast<size_t>(type)])
+		m_EnabledMask |= ToMask(type);
+	else
+		m_EnabledMask &= ~ToMask(type);
+}
+
+SteeringPlugin_Output SteeringPipeline::CalculateSteering(float deltaT, const FrameSnapshot& frame)
+{
+	m_Outputs.fill(SteeringPlugin_Output{});
+
+	if (m_Combination == SteeringCombination::Blended)
+	{
+		for (size_t i{}; i < m_Count; ++i)
+		{
+			if (m_EnabledMask & (1u << i))
+				m_Outputs[i] = m_pBehaviors[i]->CalculateSteering(deltaT, frame);
+		}
+		return Blend(frame.GetAgent());
+	}
+
+	//Priority: stop at the first behavior that wants to move, the ones after it aren't evaluated
+	const float thresholdSquared{ m_PriorityThreshold * m_PriorityThreshold };
+	size_t lastEvaluated{ m_Count };
+	for (size_t i{}; i < m_Count; ++i)
+	{
+		if (!(m_EnabledMask & (1u << i)))
+			continue;
+
+		m_Outputs[i] = m_pBehaviors[i]->CalculateSteering(deltaT, frame);
+		if (m_Outputs[i].LinearVelocity.SqrtMagnitude() > thresholdSquared)
+			return m_Outputs[i];
+		lastEvaluated = i;
+	}
+
+	//Nothing above the threshold (f.e. Face only turns), the last one still decides the orientation
+	if (lastEvaluated < m_Count)
+		return m_Outputs[lastEvaluated];
+	return SteeringPlugin_Output{};
+}
+
+SteeringPlugin_Output SteeringPipeline::Blend(const AgentInfo& agent) const
+{
+	SteeringPlugin_Output steering{};
+	float totalWeight{};
+	for (size_t i{}; i < m_Count; ++i)
+	{
+		if (!(m_EnabledMask & (1u << i)))
+			continue;
+
+		steering.LinearVelocity += m_Outputs[i].LinearVelocity * m_Weights[i];
+		steering.AngularVelocity += m_Outputs[i].AngularVelocity * m_Weights[i];
+		steering.AutoOrient = steering.AutoOrient && m_Outputs[i].AutoOrient; //One behavior turning the agent itself is enough
+		totalWeight += m_Weights[i];
+	}
+	if (totalWeight > 0.f)
+		steering.AngularVelocity /= totalWeight;
+
+	const float speedSquared{ steering.LinearVelocity.SqrtMagnitude() };
+	if (speedSquared > agent.MaxLinearSpeed * agent.MaxLinearSpeed)
+	{
+		steering.LinearVelocity.Normalize();
+		steering.LinearVelocity *= agent.MaxLinearSpeed;
+	}
+	return steering;
+}
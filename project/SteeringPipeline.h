@@ -0,0 +1,77 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// SteeringPipeline.h: Evaluates several steering behaviors every tick into a fixed output array
+// and combines them through weighted blending or priority with a threshold.
+/*=============================================================================*/
+#ifndef ELITE_STEERING_PIPELINE
+#define ELITE_STEERING_PIPELINE
+
+//-----------------------------------------------------------------
+// Includes & Forward Declarations
+//-----------------------------------------------------------------
+#include "SteeringBehaviors.h"
+#include <array>
+
+//Also the priority order: layers first, the behavior picked by the tree ("Behavior" key) after them
+enum class SteeringType : unsigned char
+{
+	//Layers
+	AvoidPurgeZone,
+	AvoidBorder,
+	//Picked by the tree
+	Seek,
+	Wander,
+	Face,
+	Evade,
+	FaceSeek,
+	Context,
+
+	Count
+};
+
+enum class SteeringCombination : unsigned char
+{
+	Blended, //Weighted sum of all enabled behaviors, clamped to the max speed of the agent
+	Priority //First enabled behavior (in SteeringType order) above the threshold wins
+};
+
+class SteeringPipeline final
+{
+public:
+	SteeringPipeline() = default;
+	~SteeringPipeline();
+
+	SteeringPipeline(const SteeringPipeline&) = delete;
+	SteeringPipeline& operator=(const SteeringPipeline&) = delete;
+
+	//Takes ownership of the behavior, it starts out disabled
+	void SetBehavior(SteeringType type, ISteeringBehavior* pBehavior, float weight = 1.f);
+	ISteeringBehavior* GetBehavior(SteeringType type) const { return m_pBehaviors[static_cast<size_t>(type)]; }
+	void SetWeight(SteeringType type, float weight) { m_Weights[static_cast<size_t>(type)] = weight; }
+	void SetEnabled(SteeringType type, bool isEnabled);
+	bool IsEnabled(SteeringType type) const { return (m_EnabledMask & ToMask(type)) != 0; }
+
+	//Threshold is the linear speed a behavior needs to win in priority mode
+	void SetCombination(SteeringCombination combination, float priorityThreshold = 0.1f)
+	{ m_Combination = combination; m_PriorityThreshold = priorityThreshold; }
+
+	SteeringPlugin_Output CalculateSteering(float deltaT, const FrameSnapshot& frame);
+	//Output of the last tick, behaviors that weren't evaluated give zero steering
+	const SteeringPlugin_Output& GetOutput(SteeringType type) const { return m_Outputs[static_cast<size_t>(type)]; }
+
+private:
+	static constexpr size_t m_Count = static_cast<size_t>(SteeringType::Count);
+	static unsigned int ToMask(SteeringType type) { return 1u << static_cast<unsigned int>(type); }
+
+	std::array<ISteeringBehavior*, m_Count> m_pBehaviors{};
+	std::array<float, m_Count> m_Weights{};
+	std::array<SteeringPlugin_Output, m_Count> m_Outputs{};
+	unsigned int m_EnabledMask = 0;
+
+	SteeringCombination m_Combination = SteeringCombination::Priority;
+	float m_PriorityThreshold = 0.1f;
+
+	SteeringPlugin_Output Blend(const AgentInfo& agent) const;
+};
+#endif
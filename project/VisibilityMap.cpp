@@ -0,0 +1,186 @@
+//Precompiled Header [ALWAYS ON TOP IN CPP]
+#include "stdafx.h"
+
+//Includes
+#include "VisibilityMap.h"
+#ifdef USE_SSE_SCANLINE_FILL
+#include <xmmintrin.h>
+#endif
+
+void VisibilityMap::Initialize(const WorldInfo& world, float cellSize)
+{
+	m_CellSize = cellSize;
+	m_Columns = static_cast<int>(ceilf(world.Dimensions.x / cellSize));
+	m_Rows = static_cast<int>(ceilf(world.Dimensions.y / cellSize));
+	m_Origin = world.Center - world.Dimensions / 2.f;
+	m_LastSeen.resize(static_cast<size_t>(m_Columns) * m_Rows);
+	Reset();
+}
+
+void VisibilityMap::Reset()
+{
+	std::fill(m_LastSeen.begin(), m_LastSeen.end(), m_NeverSeen);
+}
+
+void VisibilityMap::MarkSeen(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange, float time)
+{
+	if (m_LastSeen.empty())
+		return;
+
+	//A cone of at most 180 degrees is the range circle cut by the two edges (a convex wedge),
+	//a wider one is the circle without the convex blind wedge behind the agent
+	const bool isConvex{ fovAngle <= static_cast<float>(E_PI) };
+	const Elite::Vector2 direction{ Elite::OrientationToVector(orientation) };
+	const Elite::Vector2 axis{ isConvex ? direction : -direction };
+	const float halfAngle{ isConvex ? fovAngle / 2.f : static_cast<float>(E_PI) - fovAngle / 2.f };
+	const float cosHalf{ cosf(halfAngle) };
+	const float sinHalf{ sinf(halfAngle) };
+	const Elite::Vector2 rightEdge{ axis.x * cosHalf + axis.y * sinHalf, axis.y * cosHalf - axis.x * sinHalf };
+	const Elite::Vector2 leftEdge{ axis.x * cosHalf - axis.y * sinHalf, axis.y * cosHalf + axis.x * sinHalf };
+	//Inside the wedge is on the positive side of both normals
+	const Elite::Vector2 rightNormal{ -rightEdge.y, rightEdge.x };
+	const Elite::Vector2 leftNormal{ leftEdge.y, -leftEdge.x };
+
+	//Narrows [minX, maxX] (relative to position) to the part of the row at offset dy on the positive side of normal
+	const auto clipToHalfPlane = [](const Elite::Vector2& normal, float dy, float& minX, float& maxX)
+	{
+		const float offset{ -normal.y * dy };
+		if (abs(normal.x) < 1.e-6f)
+		{
+			if (offset > 0.f)
+				maxX = minX - 1.f; //Empty
+		}
+		else if (normal.x > 0.f)
+			minX = (std::max)(minX, offset / normal.x);
+		else
+			maxX = (std::min)(maxX, offset / normal.x);
+	};
+
+	const float rangeSquared{ fovRange * fovRange };
+	const int minRow{ (std::max)(GetRow(position.y - fovRange), 0) };
+	const int maxRow{ (std::min)(GetRow(position.y + fovRange), m_Rows - 1) };
+	for (int row{ minRow }; row <= maxRow; ++row)
+	{
+		const float dy{ m_Origin.y + (row + 0.5f) * m_CellSize - position.y };
+		if (dy * dy > rangeSquared)
+			continue;
+		const float halfChord{ sqrtf(rangeSquared - dy * dy) };
+
+		float wedgeMin{ -halfChord };
+		float wedgeMax{ halfChord };
+		clipToHalfPlane(rightNormal, dy, wedgeMin, wedgeMax);
+		clipToHalfPlane(leftNormal, dy, wedgeMin, wedgeMax);
+
+		if (isConvex)
+		{
+			FillRow(row, position.x + wedgeMin, position.x + wedgeMax, time);
+		}
+		else if (wedgeMin > wedgeMax)
+		{
+			FillRow(row, position.x - halfChord, position.x + halfChord, time);
+		}
+		else
+		{
+			FillRow(row, position.x - halfChord, position.x + wedgeMin, time);
+			FillRow(row, position.x + wedgeMax, position.x + halfChord, time);
+		}
+	}
+}
+
+float VisibilityMap::GetLastSeen(const Elite::Vector2& position) const
+{
+	const int column{ GetColumn(position.x) };
+	const int row{ GetRow(position.y) };
+	if (column < 0 || column >= m_Columns || row < 0 || row >= m_Rows)
+		return m_NeverSeen;
+	return m_LastSeen[static_cast<size_t>(row) * m_Columns + column];
+}
+
+float VisibilityMap::GetStaleness(const Elite::Vector2& min, const Elite::Vector2& max, float time) const
+{
+	const int firstColumn{ (std::max)(GetColumn(min.x), 0) };
+	const int lastColumn{ (std::min)(GetColumn(max.x), m_Columns - 1) };
+	const int firstRow{ (std::max)(GetRow(min.y), 0) };
+	const int lastRow{ (std::min)(GetRow(max.y), m_Rows - 1) };
+	if (firstColumn > lastColumn || firstRow > lastRow)
+		return 0.f;
+
+	float oldest{ time };
+	for (int row{ firstRow }; row <= lastRow; ++row)
+		oldest = (std::min)(oldest, GetOldestInRow(row, firstColumn, lastColumn));
+	return time - oldest;
+}
+
+bool VisibilityMap::FindStalest(const Elite::Vector2& center, float radius, Elite::Vector2& stalest) const
+{
+	const float radiusSquared{ radius * radius };
+	const int firstColumn{ (std::max)(GetColumn(center.x - radius), 0) };
+	const int lastColumn{ (std::min)(GetColumn(center.x + radius), m_Columns - 1) };
+	const int firstRow{ (std::max)(GetRow(center.y - radius), 0) };
+	const int lastRow{ (std::min)(GetRow(center.y + radius), m_Rows - 1) };
+
+	bool isFound{ false };
+	float oldest{ (std::numeric_limits<float>::max)() };
+	float closestDistanceSquared{ (std::numeric_limits<float>::max)() };
+	for (int row{ firstRow }; row <= lastRow; ++row)
+	{
+		const float* pRow{ m_LastSeen.data() + static_cast<size_t>(row) * m_Columns };
+		for (int column{ firstColumn }; column <= lastColumn; ++column)
+		{
+			const Elite::Vector2 cellCenter{ m_Origin + Elite::Vector2{ (column + 0.5f) * m_CellSize, (row + 0.5f) * m_CellSize } };
+			const float distanceSquared{ Elite::DistanceSquared(cellCenter, center) };
+			if (distanceSquared > radiusSquared)
+				continue;
+			if (pRow[column] < oldest || (pRow[column] == oldest && distanceSquared < closestDistanceSquared))
+			{
+				oldest = pRow[column];
+				closestDistanceSquared = distanceSquared;
+				stalest = cellCenter;
+				isFound = true;
+			}
+		}
+	}
+	return isFound;
+}
+
+void VisibilityMap::FillRow(int row, float minX, float maxX, float time)
+{
+	//Cells with their center in [minX, maxX]
+	const int firstColumn{ (std::max)(static_cast<int>(ceilf((minX - m_Origin.x) / m_CellSize - 0.5f)), 0) };
+	const int lastColumn{ (std::min)(static_cast<int>(floorf((maxX - m_Origin.x) / m_CellSize - 0.5f)), m_Columns - 1) };
+	if (firstColumn > lastColumn)
+		return;
+
+	float* pCells{ m_LastSeen.data() + static_cast<size_t>(row) * m_Columns + firstColumn };
+	const int count{ lastColumn - firstColumn + 1 };
+	int i{};
+#ifdef USE_SSE_SCANLINE_FILL
+	const __m128 value{ _mm_set1_ps(time) };
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(pCells + i, value);
+#endif
+	for (; i < count; ++i)
+		pCells[i] = time;
+}
+
+float VisibilityMap::GetOldestInRow(int row, int firstColumn, int lastColumn) const
+{
+	const float* pCells{ m_LastSeen.data() + static_cast<size_t>(row) * m_Columns + firstColumn };
+	const int count{ lastColumn - firstColumn + 1 };
+	float oldest{ (std::numeric_limits<float>::max)() };
+	int i{};
+#ifdef USE_SSE_SCANLINE_FILL
+	if (count >= 4)
+	{
+		__m128 oldest4{ _mm_loadu_ps(pCells) };
+		for (i = 4; i + 4 <= count; i += 4)
+			oldest4 = _mm_min_ps(oldest4, _mm_loadu_ps(pCells + i));
+		oldest4 = _mm_min_ps(oldest4, _mm_shuffle_ps(oldest4, oldest4, _MM_SHUFFLE(1, 0, 3, 2)));
+		oldest4 = _mm_min_ss(oldest4, _mm_shuffle_ps(oldest4, oldest4, _MM_SHUFFLE(2, 3, 0, 1)));
+		oldest = _mm_cvtss_f32(oldest4);
+	}
+#endif
+	for (; i < count; ++i)
+		oldest = (std::min)(oldest, pCells[i]);
+	return oldest;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include <vector>
+
+//=== Options ===
+#define USE_SSE_SCANLINE_FILL //Writes and scans 4 cells per instruction in VisibilityMap
+
+//Dense grid over the world with the time each cell was last in the FOV.
+//The view cone is rasterised row by row: a row of cell centers crosses the cone in one span (or two for a cone wider than 180 degrees),
+//so a tick only computes the span ends and fills them, no per cell test.
+class VisibilityMap final
+{
+public:
+	VisibilityMap() = default;
+	~VisibilityMap() = default;
+
+	void Initialize(const WorldInfo& world, float cellSize);
+	//Every cell forgets it was seen
+	void Reset();
+
+	//Stamps time on every cell with its center in the view cone
+	void MarkSeen(const Elite::Vector2& position, float orientation, float fovAngle, float fovRange, float time);
+
+	//Time the cell at position was last seen, m_NeverSeen outside of the world or when it never was
+	float GetLastSeen(const Elite::Vector2& position) const;
+	//Time since the cell at position was last seen, huge when it never was
+	float GetStaleness(const Elite::Vector2& position, float time) const { return time - GetLastSeen(position); }
+	//Time since the least recently seen cell in the rect was seen
+	float GetStaleness(const Elite::Vector2& min, const Elite::Vector2& max, float time) const;
+	//Center of the least recently seen cell within radius, the closest one of those on a tie. False when no cell is in range
+	bool FindStalest(const Elite::Vector2& center, float radius, Elite::Vector2& stalest) const;
+
+	float GetCellSize() const { return m_CellSize; }
+	int GetColumns() const { return m_Columns; }
+	int GetRows() const { return m_Rows; }
+
+	static constexpr float m_NeverSeen = -1.e30f;
+
+private:
+	std::vector<float> m_LastSeen{}; //Row major, row 0 at the bottom
+	Elite::Vector2 m_Origin = {}; //Bottom left of the world
+	float m_CellSize = 1.f;
+	int m_Columns = 0;
+	int m_Rows = 0;
+
+	void FillRow(int row, float minX, float maxX, float time);
+	float GetOldestInRow(int row, int firstColumn, int lastColumn) const;
+	int GetColumn(float x) const { return static_cast<int>(floorf((x - m_Origin.x) / m_CellSize)); }
+	int GetRow(float y) const { return static_cast<int>(floorf((y - m_Origin.y) / m_CellSize)); }
+};